@@ -0,0 +1,74 @@
+#include <chrono>
+#include <iostream>
+#include "text_format.h"
+
+/**
+ * Throughput of formatting and parsing intervals and events compared to `to_string`.
+ *
+ * Usage: TextFormatBenchmark [number of simple sets] [repetitions]
+ */
+namespace {
+
+    template<typename Function>
+    void report(const std::string &name, std::size_t repetitions, std::size_t bytes, Function function) {
+        auto start = std::chrono::steady_clock::now();
+        for (std::size_t i = 0; i < repetitions; ++i) {
+            function();
+        }
+        std::chrono::duration<double> seconds = std::chrono::steady_clock::now() - start;
+        auto megabytes = static_cast<double>(bytes * repetitions) / 1e6;
+        std::cout << name << ": " << megabytes / seconds.count() << " MB/s, "
+                  << seconds.count() / static_cast<double>(repetitions) * 1e3 << " ms per repetition\n";
+    }
+}
+
+int main(int argc, char **argv) {
+    std::size_t size = argc > 1 ? std::stoul(argv[1]) : 10000;
+    std::size_t repetitions = argc > 2 ? std::stoul(argv[2]) : 20;
+
+    SimpleSetType<SimpleInterval> simple_intervals;
+    for (std::size_t i = 0; i < size; ++i) {
+        auto lower = static_cast<float>(i) * 2.f + 0.1f;
+        simple_intervals.insert(SimpleInterval(lower, lower + 1.37f, BorderType::CLOSED, BorderType::OPEN));
+    }
+    auto interval = Interval(simple_intervals);
+
+    auto x = Continuous("x");
+    auto color = Symbolic("color", Set({"red", "green", "blue"}));
+    std::vector<VisitVariableVariant> variables{VisitVariableVariant(x), VisitVariableVariant(color)};
+    SimpleSetType<SimpleEvent> simple_events;
+    for (std::size_t i = 0; i < size / 10; ++i) {
+        auto lower = static_cast<float>(i) * 3.f + 0.25f;
+        VariableAssignmentType assignments;
+        assignments.insert({variables[0], closed(lower, lower + 1.5f)});
+        assignments.insert({variables[1], full_domain_of(variables[1])});
+        simple_events.insert(SimpleEvent(assignments));
+    }
+    auto event = Event(simple_events);
+
+    auto interval_text = format(interval);
+    auto event_text = format(event);
+    std::cout << "interval: " << interval.simple_sets.size() << " simple intervals, " << interval_text.size()
+              << " bytes\n";
+    std::cout << "event: " << event.simple_sets.size() << " simple events, " << event_text.size() << " bytes\n";
+
+    report("Interval::to_string", repetitions, interval.to_string().size(), [&interval]() {
+        return interval.to_string();
+    });
+    TextWriter writer;
+    report("TextWriter interval", repetitions, interval_text.size(), [&writer, &interval]() {
+        writer.clear();
+        writer.write(interval);
+    });
+    report("parse_interval", repetitions, interval_text.size(), [&interval_text]() {
+        return parse_interval(interval_text);
+    });
+    report("TextWriter event", repetitions, event_text.size(), [&writer, &event]() {
+        writer.clear();
+        writer.write(event);
+    });
+    report("parse_event", repetitions, event_text.size(), [&event_text, &variables]() {
+        return parse_event(event_text, variables);
+    });
+    return 0;
+}
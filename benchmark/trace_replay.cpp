@@ -0,0 +1,73 @@
+#include <algorithm>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <vector>
+#include "trace.h"
+
+/**
+ * Replay a trace that was captured with the TraceRecorder against the current build and report the latency
+ * distribution of every operation next to the recorded one.
+ *
+ * Usage: TraceReplay <trace file> [repetitions]
+ */
+namespace {
+
+    struct Latencies {
+        std::vector<double> recorded;
+        std::vector<double> replayed;
+    };
+
+    double percentile(std::vector<double> &values, double fraction) {
+        if (values.empty()) {
+            return 0;
+        }
+        auto position = static_cast<std::size_t>(fraction * static_cast<double>(values.size() - 1));
+        std::nth_element(values.begin(), values.begin() + static_cast<std::ptrdiff_t>(position), values.end());
+        return values[position];
+    }
+
+    void print_distribution(const std::string &name, std::vector<double> &microseconds) {
+        double mean = 0;
+        for (auto value: microseconds) {
+            mean += value / static_cast<double>(microseconds.size());
+        }
+        std::cout << std::setw(12) << name << std::fixed << std::setprecision(2)
+                  << std::setw(12) << mean
+                  << std::setw(12) << percentile(microseconds, 0.5)
+                  << std::setw(12) << percentile(microseconds, 0.9)
+                  << std::setw(12) << percentile(microseconds, 0.99)
+                  << std::setw(12) << percentile(microseconds, 1.0) << "\n";
+    }
+}
+
+int main(int argc, char **argv) {
+    if (argc < 2) {
+        std::cerr << "Usage: " << argv[0] << " <trace file> [repetitions]\n";
+        return 1;
+    }
+    std::size_t repetitions = argc > 2 ? std::stoul(argv[2]) : 1;
+
+    std::map<TracedOperation, Latencies> latencies;
+    TraceReader reader(argv[1]);
+    while (auto record = reader.next()) {
+        auto &operation_latencies = latencies[record->operation];
+        operation_latencies.recorded.push_back(static_cast<double>(record->duration.count()) / 1e3);
+
+        for (std::size_t i = 0; i < repetitions; ++i) {
+            auto start = std::chrono::steady_clock::now();
+            auto result = record->replay();
+            std::chrono::duration<double, std::micro> duration = std::chrono::steady_clock::now() - start;
+            operation_latencies.replayed.push_back(duration.count());
+        }
+    }
+
+    for (auto &[operation, operation_latencies]: latencies) {
+        std::cout << to_string(operation) << ": " << operation_latencies.recorded.size() << " operations\n";
+        std::cout << std::setw(12) << "[us]" << std::setw(12) << "mean" << std::setw(12) << "p50"
+                  << std::setw(12) << "p90" << std::setw(12) << "p99" << std::setw(12) << "max" << "\n";
+        print_distribution("recorded", operation_latencies.recorded);
+        print_distribution("replayed", operation_latencies.replayed);
+    }
+    return 0;
+}
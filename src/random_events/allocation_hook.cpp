@@ -0,0 +1,170 @@
+#include <atomic>
+#include <cstdlib>
+#include <new>
+#include "allocation_hook.h"
+
+namespace {
+    std::atomic<AllocationHook> installed_hook{nullptr};
+    std::atomic<std::size_t> live_bytes{0};
+    std::atomic<std::size_t> total_allocations{0};
+    thread_local std::size_t thread_allocations = 0;
+    thread_local std::size_t thread_bytes = 0;
+
+    /**
+     * Every allocation is prefixed with a header that stores its size, such that unsized deletes can be accounted.
+     * The header keeps the default new alignment.
+     */
+    constexpr std::size_t header_size = __STDCPP_DEFAULT_NEW_ALIGNMENT__;
+
+    /**
+     * @return The size of the header of an allocation with the given alignment, which keeps the alignment.
+     */
+    constexpr std::size_t header_size_for(std::size_t alignment) {
+        return alignment > header_size ? alignment : header_size;
+    }
+
+    void *allocate(std::size_t size, std::size_t alignment = header_size) {
+        auto header = header_size_for(alignment);
+        void *raw;
+        if (alignment > header_size) {
+
+            // aligned_alloc requires the size to be a multiple of the alignment
+            raw = std::aligned_alloc(alignment, (size + header + alignment - 1) / alignment * alignment);
+        } else {
+            raw = std::malloc(size + header);
+        }
+        if (raw == nullptr) {
+            return nullptr;
+        }
+        *static_cast<std::size_t *>(raw) = size;
+        live_bytes.fetch_add(size, std::memory_order_relaxed);
+        total_allocations.fetch_add(1, std::memory_order_relaxed);
+        ++thread_allocations;
+        thread_bytes += size;
+        if (auto hook = installed_hook.load(std::memory_order_acquire)) {
+            hook(static_cast<std::ptrdiff_t>(size));
+        }
+        return static_cast<char *>(raw) + header;
+    }
+
+    void *allocate_or_throw(std::size_t size, std::size_t alignment = header_size) {
+        void *result = allocate(size, alignment);
+        if (result == nullptr) {
+            throw std::bad_alloc();
+        }
+        return result;
+    }
+
+    void deallocate(void *pointer, std::size_t alignment = header_size) {
+        if (pointer == nullptr) {
+            return;
+        }
+        void *raw = static_cast<char *>(pointer) - header_size_for(alignment);
+        std::size_t size = *static_cast<std::size_t *>(raw);
+        live_bytes.fetch_sub(size, std::memory_order_relaxed);
+        if (auto hook = installed_hook.load(std::memory_order_acquire)) {
+            hook(-static_cast<std::ptrdiff_t>(size));
+        }
+        std::free(raw);
+    }
+}
+
+AllocationHook set_allocation_hook(AllocationHook hook) {
+    return installed_hook.exchange(hook, std::memory_order_acq_rel);
+}
+
+std::size_t allocated_bytes() {
+    return live_bytes.load(std::memory_order_relaxed);
+}
+
+std::size_t allocation_count() {
+    return total_allocations.load(std::memory_order_relaxed);
+}
+
+std::size_t thread_allocation_count() {
+    return thread_allocations;
+}
+
+std::size_t thread_allocated_bytes() {
+    return thread_bytes;
+}
+
+void *operator new(std::size_t size) {
+    return allocate_or_throw(size);
+}
+
+void *operator new[](std::size_t size) {
+    return allocate_or_throw(size);
+}
+
+void *operator new(std::size_t size, const std::nothrow_t &) noexcept {
+    return allocate(size);
+}
+
+void *operator new[](std::size_t size, const std::nothrow_t &) noexcept {
+    return allocate(size);
+}
+
+void operator delete(void *pointer) noexcept {
+    deallocate(pointer);
+}
+
+void operator delete[](void *pointer) noexcept {
+    deallocate(pointer);
+}
+
+void operator delete(void *pointer, std::size_t) noexcept {
+    deallocate(pointer);
+}
+
+void operator delete[](void *pointer, std::size_t) noexcept {
+    deallocate(pointer);
+}
+
+void operator delete(void *pointer, const std::nothrow_t &) noexcept {
+    deallocate(pointer);
+}
+
+void operator delete[](void *pointer, const std::nothrow_t &) noexcept {
+    deallocate(pointer);
+}
+
+void *operator new(std::size_t size, std::align_val_t alignment) {
+    return allocate_or_throw(size, static_cast<std::size_t>(alignment));
+}
+
+void *operator new[](std::size_t size, std::align_val_t alignment) {
+    return allocate_or_throw(size, static_cast<std::size_t>(alignment));
+}
+
+void *operator new(std::size_t size, std::align_val_t alignment, const std::nothrow_t &) noexcept {
+    return allocate(size, static_cast<std::size_t>(alignment));
+}
+
+void *operator new[](std::size_t size, std::align_val_t alignment, const std::nothrow_t &) noexcept {
+    return allocate(size, static_cast<std::size_t>(alignment));
+}
+
+void operator delete(void *pointer, std::align_val_t alignment) noexcept {
+    deallocate(pointer, static_cast<std::size_t>(alignment));
+}
+
+void operator delete[](void *pointer, std::align_val_t alignment) noexcept {
+    deallocate(pointer, static_cast<std::size_t>(alignment));
+}
+
+void operator delete(void *pointer, std::size_t, std::align_val_t alignment) noexcept {
+    deallocate(pointer, static_cast<std::size_t>(alignment));
+}
+
+void operator delete[](void *pointer, std::size_t, std::align_val_t alignment) noexcept {
+    deallocate(pointer, static_cast<std::size_t>(alignment));
+}
+
+void operator delete(void *pointer, std::align_val_t alignment, const std::nothrow_t &) noexcept {
+    deallocate(pointer, static_cast<std::size_t>(alignment));
+}
+
+void operator delete[](void *pointer, std::align_val_t alignment, const std::nothrow_t &) noexcept {
+    deallocate(pointer, static_cast<std::size_t>(alignment));
+}
@@ -0,0 +1,550 @@
+#include <algorithm>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include "arrow_interface.h"
+
+namespace {
+
+    /**
+     * Deleter that releases an exported schema or array, unless the consumer moved it out, and frees it.
+     */
+    struct Release {
+        template<typename T>
+        void operator()(T *exported) const {
+            if (exported->release != nullptr) {
+                exported->release(exported);
+            }
+            delete exported;
+        }
+    };
+
+    /**
+     * An exported schema or array that is owned until it is handed to its parent.
+     */
+    template<typename T>
+    using Owned = std::unique_ptr<T, Release>;
+
+    /**
+     * Owner of the buffers and children of an exported array, stored as its private data.
+     */
+    struct ExportedArray {
+        std::vector<std::shared_ptr<void>> owners;
+        std::vector<const void *> buffers;
+        std::vector<ArrowArray *> children;
+        ArrowArray *dictionary = nullptr;
+
+        ExportedArray() = default;
+
+        ExportedArray(const ExportedArray &) = delete;
+
+        ExportedArray &operator=(const ExportedArray &) = delete;
+
+        ~ExportedArray() {
+            for (auto child: children) {
+                Release()(child);
+            }
+            if (dictionary != nullptr) {
+                Release()(dictionary);
+            }
+        }
+
+        void add_child(Owned<ArrowArray> child) {
+            children.push_back(child.get());
+            child.release();
+        }
+    };
+
+    void release_array(ArrowArray *array) {
+        delete static_cast<ExportedArray *>(array->private_data);
+        array->release = nullptr;
+    }
+
+    /**
+     * Move a vector into the owners of an array.
+     *
+     * @return The data of the vector, which is never null.
+     */
+    template<typename T>
+    const void *own(ExportedArray &exported, std::vector<T> &&values) {
+        values.reserve(1);
+        auto owner = std::make_shared<std::vector<T>>(std::move(values));
+        exported.owners.push_back(owner);
+        return owner->data();
+    }
+
+    void fill_array(ArrowArray *array, std::int64_t length, std::int64_t null_count,
+                    std::unique_ptr<ExportedArray> exported) {
+        array->length = length;
+        array->null_count = null_count;
+        array->offset = 0;
+        array->n_buffers = static_cast<std::int64_t>(exported->buffers.size());
+        array->n_children = static_cast<std::int64_t>(exported->children.size());
+        array->buffers = exported->buffers.data();
+        array->children = exported->children.empty() ? nullptr : exported->children.data();
+        array->dictionary = exported->dictionary;
+        array->release = &release_array;
+        array->private_data = exported.release();
+    }
+
+    template<typename T>
+    Owned<ArrowArray> new_primitive_array(std::vector<T> &&values) {
+        auto length = static_cast<std::int64_t>(values.size());
+        auto exported = std::make_unique<ExportedArray>();
+        exported->buffers = {nullptr, own(*exported, std::move(values))};
+        Owned<ArrowArray> array(new ArrowArray{});
+        fill_array(array.get(), length, 0, std::move(exported));
+        return array;
+    }
+
+    /**
+     * Owner of the strings and children of an exported schema, stored as its private data.
+     */
+    struct ExportedSchema {
+        std::string format;
+        std::string name;
+        std::vector<ArrowSchema *> children;
+        ArrowSchema *dictionary = nullptr;
+
+        ExportedSchema() = default;
+
+        ExportedSchema(const ExportedSchema &) = delete;
+
+        ExportedSchema &operator=(const ExportedSchema &) = delete;
+
+        ~ExportedSchema() {
+            for (auto child: children) {
+                Release()(child);
+            }
+            if (dictionary != nullptr) {
+                Release()(dictionary);
+            }
+        }
+    };
+
+    void release_schema(ArrowSchema *schema) {
+        delete static_cast<ExportedSchema *>(schema->private_data);
+        schema->release = nullptr;
+    }
+
+    void fill_schema(ArrowSchema *schema, std::string format, std::string name,
+                     std::vector<Owned<ArrowSchema>> children = {}, Owned<ArrowSchema> dictionary = nullptr,
+                     std::int64_t flags = 0) {
+        auto exported = std::make_unique<ExportedSchema>();
+        exported->format = std::move(format);
+        exported->name = std::move(name);
+        exported->children.reserve(children.size());
+        for (auto &child: children) {
+            exported->children.push_back(child.release());
+        }
+        exported->dictionary = dictionary.release();
+
+        schema->format = exported->format.c_str();
+        schema->name = exported->name.c_str();
+        schema->metadata = nullptr;
+        schema->flags = flags;
+        schema->n_children = static_cast<std::int64_t>(exported->children.size());
+        schema->children = exported->children.empty() ? nullptr : exported->children.data();
+        schema->dictionary = exported->dictionary;
+        schema->release = &release_schema;
+        schema->private_data = exported.release();
+    }
+
+    Owned<ArrowSchema> new_schema(std::string format, std::string name, std::vector<Owned<ArrowSchema>> children = {},
+                                  Owned<ArrowSchema> dictionary = nullptr, std::int64_t flags = 0) {
+        Owned<ArrowSchema> schema(new ArrowSchema{});
+        fill_schema(schema.get(), std::move(format), std::move(name), std::move(children), std::move(dictionary),
+                    flags);
+        return schema;
+    }
+
+    void fill_columns_schema(ArrowSchema *schema, std::string name) {
+        std::vector<Owned<ArrowSchema>> children;
+        children.push_back(new_schema("f", "lower"));
+        children.push_back(new_schema("f", "upper"));
+        children.push_back(new_schema("C", "borders"));
+        fill_schema(schema, "+s", std::move(name), std::move(children));
+    }
+
+    void fill_columns_array(ArrowArray *array, SimpleIntervalColumns &&columns) {
+        auto length = static_cast<std::int64_t>(columns.size());
+        auto exported = std::make_unique<ExportedArray>();
+        exported->buffers = {nullptr};
+        exported->add_child(new_primitive_array(std::move(columns.lower)));
+        exported->add_child(new_primitive_array(std::move(columns.upper)));
+        exported->add_child(new_primitive_array(std::move(columns.borders)));
+        fill_array(array, length, 0, std::move(exported));
+    }
+
+    /**
+     * Export the elements of a domain as utf8 array.
+     */
+    Owned<ArrowArray> new_string_array(const std::vector<std::string> &strings) {
+        std::vector<std::int32_t> offsets{0};
+        std::vector<char> characters;
+        for (const auto &string: strings) {
+            characters.insert(characters.end(), string.begin(), string.end());
+            offsets.push_back(static_cast<std::int32_t>(characters.size()));
+        }
+        auto exported = std::make_unique<ExportedArray>();
+        exported->buffers = {nullptr, own(*exported, std::move(offsets)), own(*exported, std::move(characters))};
+        Owned<ArrowArray> array(new ArrowArray{});
+        fill_array(array.get(), static_cast<std::int64_t>(strings.size()), 0, std::move(exported));
+        return array;
+    }
+
+    std::string name_of(const VisitVariableVariant &variable) {
+        return std::visit([](const auto &variable_) -> std::string {
+            if constexpr (std::is_same_v<std::decay_t<decltype(variable_)>, std::monostate>) {
+                return {};
+            } else {
+                return variable_.name;
+            }
+        }, variable.variable_variant);
+    }
+
+    /**
+     * Offsets into the items of a list column and the rows that do not assign the variable.
+     */
+    struct ListColumn {
+        std::vector<std::int32_t> offsets{0};
+        std::vector<std::uint8_t> validity;
+        std::int64_t null_count = 0;
+
+        explicit ListColumn(std::size_t rows) : validity((rows + 7) / 8, 0) {}
+
+        void end_row(std::size_t row, std::size_t items, bool valid) {
+            if (items > static_cast<std::size_t>(std::numeric_limits<std::int32_t>::max())) {
+                throw std::invalid_argument("Arrow lists cannot hold more than 2^31 - 1 items.");
+            }
+            offsets.push_back(static_cast<std::int32_t>(items));
+            if (valid) {
+                validity[row / 8] |= static_cast<std::uint8_t>(1u << (row % 8));
+            } else {
+                ++null_count;
+            }
+        }
+
+        Owned<ArrowArray> to_array(Owned<ArrowArray> items) {
+            auto length = static_cast<std::int64_t>(offsets.size() - 1);
+            auto exported = std::make_unique<ExportedArray>();
+            auto null_count_ = null_count;
+            exported->buffers = {null_count_ == 0 ? nullptr : own(*exported, std::move(validity)),
+                                 own(*exported, std::move(offsets))};
+            exported->add_child(std::move(items));
+            Owned<ArrowArray> array(new ArrowArray{});
+            fill_array(array.get(), length, null_count_, std::move(exported));
+            return array;
+        }
+    };
+}
+
+void export_columns(SimpleIntervalColumns columns, ArrowSchema *schema, ArrowArray *array) {
+    fill_columns_schema(schema, "");
+    fill_columns_array(array, std::move(columns));
+}
+
+void export_interval(const Interval &interval, ArrowSchema *schema, ArrowArray *array) {
+    export_columns(SimpleIntervalColumns(interval), schema, array);
+}
+
+void export_event(const Event &event, ArrowSchema *schema, ArrowArray *array) {
+    std::set<VisitVariableVariant> variables;
+    for (const auto &simple_event: event.simple_sets) {
+        for (const auto &[variable, assignment]: simple_event.variable_assignments) {
+            variables.insert(variable);
+        }
+    }
+
+    // the columns exported so far are released if a later column is rejected
+    auto rows = event.simple_sets.size();
+    std::vector<Owned<ArrowSchema>> column_schemas;
+    auto exported = std::make_unique<ExportedArray>();
+    exported->buffers = {nullptr};
+
+    for (const auto &variable: variables) {
+        ListColumn column(rows);
+        Owned<ArrowSchema> item_schema;
+        Owned<ArrowArray> items;
+
+        if (std::holds_alternative<Symbolic>(variable.variable_variant)) {
+            const auto &all_elements = std::get<Symbolic>(variable.variable_variant).domain.all_elements;
+            std::vector<std::string> elements(all_elements.begin(), all_elements.end());
+            std::vector<std::int32_t> indices;
+            std::size_t row = 0;
+            for (const auto &simple_event: event.simple_sets) {
+                auto assignment = simple_event.variable_assignments.find(variable);
+                if (assignment != simple_event.variable_assignments.end()) {
+                    for (const auto &simple_set: std::get<Set>(assignment->second).simple_sets) {
+                        auto index = std::lower_bound(elements.begin(), elements.end(), simple_set.element);
+                        if (index == elements.end() || *index != simple_set.element) {
+                            throw std::invalid_argument("The element '" + simple_set.element +
+                                                        "' is not in the domain of " + name_of(variable) + ".");
+                        }
+                        indices.push_back(static_cast<std::int32_t>(index - elements.begin()));
+                    }
+                }
+                column.end_row(row++, indices.size(), assignment != simple_event.variable_assignments.end());
+            }
+            item_schema = new_schema("i", "item", {}, new_schema("u", ""));
+            items = new_primitive_array(std::move(indices));
+            auto &exported_items = *static_cast<ExportedArray *>(items->private_data);
+            exported_items.dictionary = new_string_array(elements).release();
+            items->dictionary = exported_items.dictionary;
+        } else {
+            SimpleIntervalColumns simple_intervals;
+            std::size_t row = 0;
+            for (const auto &simple_event: event.simple_sets) {
+                auto assignment = simple_event.variable_assignments.find(variable);
+                if (assignment != simple_event.variable_assignments.end()) {
+                    for (const auto &simple_interval: std::get<Interval>(assignment->second).simple_sets) {
+                        simple_intervals.push_back(simple_interval);
+                    }
+                }
+                column.end_row(row++, simple_intervals.size(),
+                               assignment != simple_event.variable_assignments.end());
+            }
+            item_schema.reset(new ArrowSchema{});
+            fill_columns_schema(item_schema.get(), "item");
+            items.reset(new ArrowArray{});
+            fill_columns_array(items.get(), std::move(simple_intervals));
+        }
+
+        std::vector<Owned<ArrowSchema>> list_children;
+        list_children.push_back(std::move(item_schema));
+        column_schemas.push_back(new_schema("+l", name_of(variable), std::move(list_children), nullptr,
+                                            ARROW_FLAG_NULLABLE));
+        exported->add_child(column.to_array(std::move(items)));
+    }
+
+    fill_schema(schema, "+s", "", std::move(column_schemas));
+    fill_array(array, static_cast<std::int64_t>(rows), 0, std::move(exported));
+}
+
+namespace {
+
+    /**
+     * Release an imported schema and array when leaving the scope.
+     */
+    struct ImportGuard {
+        ArrowSchema *schema;
+        ArrowArray *array;
+
+        ~ImportGuard() {
+            if (array != nullptr && array->release != nullptr) {
+                array->release(array);
+            }
+            if (schema != nullptr && schema->release != nullptr) {
+                schema->release(schema);
+            }
+        }
+    };
+
+    void check(bool condition, const std::string &message) {
+        if (!condition) {
+            throw std::invalid_argument("Invalid Arrow data: " + message + ".");
+        }
+    }
+
+    /**
+     * Check the format and number of children of a schema and that its children are present, which may still be null.
+     */
+    void check_format(const ArrowSchema *schema, std::string_view format, std::int64_t n_children,
+                      const std::string &what) {
+        check(schema != nullptr && schema->format != nullptr && schema->format == format &&
+              schema->n_children == n_children, what + " must have the format '" + std::string(format) + "'");
+        check(n_children == 0 || schema->children != nullptr, what + " is missing its children");
+    }
+
+    /**
+     * Check the number of buffers and children of an array and that all buffers except for the validity bitmap are
+     * present. The children are present, but may still be null.
+     */
+    void check_array(const ArrowArray *array, std::int64_t n_buffers, std::int64_t n_children,
+                     const std::string &what) {
+        check(array != nullptr && array->release != nullptr && array->n_buffers == n_buffers &&
+              array->n_children == n_children, what + " has an unexpected number of buffers or children");
+        check(n_buffers == 0 || array->buffers != nullptr, what + " is missing its buffers");
+        for (std::int64_t buffer = 1; buffer < n_buffers; ++buffer) {
+            check(array->buffers[buffer] != nullptr, what + " is missing a buffer");
+        }
+        check(n_children == 0 || array->children != nullptr, what + " is missing its children");
+    }
+
+    /**
+     * @return True if the entry at the position, relative to the offset of the array, is not null.
+     */
+    bool is_valid(const ArrowArray *array, std::int64_t position) {
+        if (array->null_count == 0 || array->buffers[0] == nullptr) {
+            return true;
+        }
+        auto index = array->offset + position;
+        return (static_cast<const std::uint8_t *>(array->buffers[0])[index / 8] >> (index % 8)) & 1u;
+    }
+
+    /**
+     * @return The values of a buffer, starting at the offset of the array.
+     */
+    template<typename T>
+    const T *values_of(const ArrowArray *array, std::int64_t buffer) {
+        return static_cast<const T *>(array->buffers[buffer]) + array->offset;
+    }
+
+    void check_columns(const ArrowSchema *schema, const ArrowArray *array) {
+        check_format(schema, "+s", 3, "Simple intervals");
+        check_format(schema->children[0], "f", 0, "Lower bounds");
+        check_format(schema->children[1], "f", 0, "Upper bounds");
+        check_format(schema->children[2], "C", 0, "Borders");
+        check_array(array, 1, 3, "Simple intervals");
+        check(array->null_count == 0, "Simple intervals must not be null");
+        for (std::int64_t child = 0; child < 3; ++child) {
+            check_array(array->children[child], 2, 0, "Simple interval column");
+            check(array->children[child]->null_count == 0, "Simple interval columns must not contain nulls");
+            check(array->children[child]->length >= array->offset + array->length,
+                  "Simple interval columns are shorter than their struct");
+        }
+    }
+
+    /**
+     * @return The simple interval at the position, relative to the offset of the struct array.
+     */
+    SimpleInterval simple_interval_at(const ArrowArray *array, std::int64_t position) {
+        auto index = array->offset + position;
+        auto borders = values_of<std::uint8_t>(array->children[2], 1)[index];
+        return SimpleInterval{values_of<float>(array->children[0], 1)[index],
+                              values_of<float>(array->children[1], 1)[index],
+                              (borders & SimpleIntervalColumns::LEFT_CLOSED) ? BorderType::CLOSED : BorderType::OPEN,
+                              (borders & SimpleIntervalColumns::RIGHT_CLOSED) ? BorderType::CLOSED : BorderType::OPEN};
+    }
+
+    Interval interval_of(const ArrowArray *array, std::int64_t begin, std::int64_t end) {
+        SimpleSetType<SimpleInterval> simple_intervals;
+        for (auto position = begin; position < end; ++position) {
+            auto simple_interval = simple_interval_at(array, position);
+            if (!simple_interval.is_empty()) {
+                simple_intervals.insert(simple_interval);
+            }
+        }
+        return Interval(simple_intervals);
+    }
+
+    /**
+     * Decode a utf8 dictionary and check that its strings are elements of a domain.
+     */
+    std::vector<const std::string *> decode_dictionary(const ArrowSchema *schema, const ArrowArray *array,
+                                                       const std::set<std::string> &all_elements) {
+        check_format(schema, "u", 0, "Dictionaries of symbolic columns");
+        check_array(array, 3, 0, "Dictionary");
+        check(array->null_count == 0, "Dictionaries must not contain nulls");
+        auto offsets = values_of<std::int32_t>(array, 1);
+        auto characters = static_cast<const char *>(array->buffers[2]);
+        std::vector<const std::string *> result;
+        for (std::int64_t position = 0; position < array->length; ++position) {
+            std::string element(characters + offsets[position],
+                                static_cast<std::size_t>(offsets[position + 1] - offsets[position]));
+            auto known_element = all_elements.find(element);
+            check(known_element != all_elements.end(), "Unknown element '" + element + "'");
+            result.push_back(&*known_element);
+        }
+        return result;
+    }
+}
+
+SimpleIntervalColumns import_columns(ArrowSchema *schema, ArrowArray *array) {
+    ImportGuard guard{schema, array};
+    check_columns(schema, array);
+    SimpleIntervalColumns result;
+    result.reserve(static_cast<std::size_t>(array->length));
+    for (std::int64_t position = 0; position < array->length; ++position) {
+        result.push_back(simple_interval_at(array, position));
+    }
+    return result;
+}
+
+Interval import_interval(ArrowSchema *schema, ArrowArray *array) {
+    ImportGuard guard{schema, array};
+    check_columns(schema, array);
+    return interval_of(array, 0, array->length);
+}
+
+Event import_event(ArrowSchema *schema, ArrowArray *array, const std::vector<VisitVariableVariant> &variables) {
+    ImportGuard guard{schema, array};
+    check(schema != nullptr && schema->format != nullptr && std::string_view(schema->format) == "+s",
+          "Events must have the format '+s'");
+    check_array(array, 1, schema->n_children, "Event");
+
+    // the variable of every column and, for symbolic columns, the decoded dictionary
+    std::vector<const VisitVariableVariant *> column_variables;
+    std::vector<std::vector<const std::string *>> dictionaries;
+    check(schema->n_children == 0 || schema->children != nullptr, "Events are missing their columns");
+    for (std::int64_t column = 0; column < schema->n_children; ++column) {
+        const auto *column_schema = schema->children[column];
+        check(column_schema != nullptr && array->children[column] != nullptr, "Columns of events must not be null");
+        std::string name = column_schema->name == nullptr ? "" : column_schema->name;
+        auto variable = std::find_if(variables.begin(), variables.end(), [&name](const auto &candidate) {
+            return name_of(candidate) == name;
+        });
+        check(variable != variables.end(), "Unknown variable '" + name + "'");
+        column_variables.push_back(&*variable);
+
+        check_format(column_schema, "+l", 1, "The column of " + name);
+        const auto *list = array->children[column];
+        check_array(list, 2, 1, "The column of " + name);
+        check(list->length >= array->offset + array->length, "The column of " + name + " is too short");
+        const auto *item_schema = column_schema->children[0];
+        const auto *items = list->children[0];
+
+        if (std::holds_alternative<Symbolic>(variable->variable_variant)) {
+            check_format(item_schema, "i", 0, "The items of " + name);
+            check_array(items, 2, 0, "The items of " + name);
+            check(items->null_count == 0, "The items of " + name + " must not be null");
+            check(item_schema->dictionary != nullptr && items->dictionary != nullptr,
+                  "The items of " + name + " must be dictionary encoded");
+            dictionaries.push_back(decode_dictionary(item_schema->dictionary, items->dictionary,
+                                                     std::get<Symbolic>(variable->variable_variant)
+                                                             .domain.all_elements));
+        } else {
+            check_columns(item_schema, items);
+            dictionaries.emplace_back();
+        }
+    }
+
+    SimpleSetType<SimpleEvent> simple_events;
+    for (std::int64_t row = 0; row < array->length; ++row) {
+        if (!is_valid(array, row)) {
+            continue;
+        }
+        VariableAssignmentType assignments;
+        for (std::size_t column = 0; column < column_variables.size(); ++column) {
+            const auto *list = array->children[column];
+            auto position = array->offset + row;
+            if (!is_valid(list, position)) {
+                continue;
+            }
+            auto begin = values_of<std::int32_t>(list, 1)[position];
+            auto end = values_of<std::int32_t>(list, 1)[position + 1];
+            const auto *items = list->children[0];
+            check(0 <= begin && begin <= end && end <= items->length, "Invalid list offsets");
+
+            const auto &variable = *column_variables[column];
+            if (std::holds_alternative<Symbolic>(variable.variable_variant)) {
+                const auto &all_elements = std::get<Symbolic>(variable.variable_variant).domain.all_elements;
+                const auto &dictionary = dictionaries[column];
+                SimpleSetType<SimpleSet> elements;
+                for (auto item = begin; item < end; ++item) {
+                    auto index = values_of<std::int32_t>(items, 1)[item];
+                    check(0 <= index && static_cast<std::size_t>(index) < dictionary.size(),
+                          "Dictionary index out of range");
+                    elements.insert(SimpleSet(*dictionary[static_cast<std::size_t>(index)], all_elements));
+                }
+                assignments.insert({variable, Set(elements, all_elements)});
+            } else {
+                assignments.insert({variable, interval_of(items, begin, end)});
+            }
+        }
+        simple_events.insert(SimpleEvent(assignments));
+    }
+    return Event(simple_events);
+}
@@ -0,0 +1,254 @@
+#include <algorithm>
+#include <stdexcept>
+#include "columnar_event.h"
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define RANDOM_EVENTS_AVX2_KERNEL 1
+#include <immintrin.h>
+#endif
+
+ColumnarEvent::ColumnarEvent(const std::set<VisitVariableVariant> &variables) :
+        variables(variables.begin(), variables.end()), dimensions(variables.size()) {
+    for (const auto &variable: this->variables) {
+        if (!std::holds_alternative<Continuous>(variable.variable_variant) &&
+            !std::holds_alternative<Integer>(variable.variable_variant)) {
+            throw std::invalid_argument("Columnar events only support variables that are assigned intervals.");
+        }
+    }
+}
+
+namespace {
+    std::set<VisitVariableVariant> variables_of(const Event &event) {
+        std::set<VisitVariableVariant> result;
+        for (const auto &simple_event: event.simple_sets) {
+            for (const auto &[variable, assignment]: simple_event.variable_assignments) {
+                result.insert(variable);
+            }
+        }
+        return result;
+    }
+}
+
+ColumnarEvent::ColumnarEvent(const Event &event) : ColumnarEvent(event, variables_of(event)) {}
+
+ColumnarEvent::ColumnarEvent(const Event &event, const std::set<VisitVariableVariant> &variables) :
+        ColumnarEvent(variables) {
+    for (const auto &simple_event: event.simple_sets) {
+        push_back(simple_event);
+    }
+}
+
+void ColumnarEvent::push_back(const SimpleEvent &simple_event) {
+    for (const auto &[variable, assignment]: simple_event.variable_assignments) {
+        if (!std::binary_search(variables.begin(), variables.end(), variable)) {
+            throw std::invalid_argument("The simple event assigns a variable that is not a dimension.");
+        }
+    }
+
+    // the simple intervals of every dimension, where unassigned variables take the real line
+    std::vector<SimpleIntervalColumns> pieces;
+    pieces.reserve(variables.size());
+    for (const auto &variable: variables) {
+        auto assignment = simple_event.variable_assignments.find(variable);
+        if (assignment == simple_event.variable_assignments.end()) {
+            pieces.emplace_back(reals());
+        } else {
+            pieces.emplace_back(std::get<Interval>(assignment->second));
+        }
+        if (pieces.back().size() == 0) {
+            return;
+        }
+    }
+
+    // append every combination of simple intervals by counting through the positions like an odometer
+    std::vector<std::size_t> positions(variables.size(), 0);
+    while (true) {
+        for (std::size_t dimension = 0; dimension < variables.size(); ++dimension) {
+            const auto &dimension_pieces = pieces[dimension];
+            auto position = positions[dimension];
+            dimensions[dimension].lower.push_back(dimension_pieces.lower[position]);
+            dimensions[dimension].upper.push_back(dimension_pieces.upper[position]);
+            dimensions[dimension].borders.push_back(dimension_pieces.borders[position]);
+        }
+
+        std::size_t dimension = 0;
+        for (; dimension < variables.size(); ++dimension) {
+            if (++positions[dimension] < pieces[dimension].size()) {
+                break;
+            }
+            positions[dimension] = 0;
+        }
+        if (dimension == variables.size()) {
+            return;
+        }
+    }
+}
+
+SimpleEvent ColumnarEvent::box(std::size_t position) const {
+    VariableAssignmentType assignments;
+    for (std::size_t dimension = 0; dimension < variables.size(); ++dimension) {
+        assignments.insert({variables[dimension], Interval(dimensions[dimension].at(position))});
+    }
+    return SimpleEvent(assignments);
+}
+
+Event ColumnarEvent::to_event() const {
+    Event result;
+    for (std::size_t position = 0; position < size(); ++position) {
+        result.simple_sets.insert(box(position));
+    }
+    return result;
+}
+
+std::size_t ColumnarEvent::size() const {
+    return dimensions.empty() ? 0 : dimensions.front().size();
+}
+
+void ColumnarEvent::check_variables(const ColumnarEvent &other) const {
+    if (variables != other.variables) {
+        throw std::invalid_argument("Columnar events can only be compared if they have the same variables.");
+    }
+}
+
+bool ColumnarEvent::boxes_overlap(std::size_t position, const ColumnarEvent &other,
+                                  std::size_t other_position) const {
+    check_variables(other);
+    for (std::size_t dimension = 0; dimension < dimensions.size(); ++dimension) {
+        if (!simple_intervals_overlap(dimensions[dimension], position, other.dimensions[dimension],
+                                      other_position)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void box_overlap_mask_scalar(const std::vector<SimpleIntervalColumns> &dimensions, std::size_t begin,
+                             const std::vector<SimpleIntervalColumns> &other_dimensions, std::size_t other_position,
+                             std::vector<std::uint8_t> &mask) {
+    auto size = dimensions.empty() ? 0 : dimensions.front().size();
+    mask.assign(size - begin, 1);
+    for (std::size_t dimension = 0; dimension < dimensions.size(); ++dimension) {
+        for (std::size_t position = begin; position < size; ++position) {
+            mask[position - begin] &= simple_intervals_overlap(dimensions[dimension], position,
+                                                               other_dimensions[dimension], other_position);
+        }
+    }
+}
+
+#ifdef RANDOM_EVENTS_AVX2_KERNEL
+__attribute__((target("avx2")))
+void box_overlap_mask_avx2(const std::vector<SimpleIntervalColumns> &dimensions, std::size_t begin,
+                           const std::vector<SimpleIntervalColumns> &other_dimensions, std::size_t other_position,
+                           std::vector<std::uint8_t> &mask) {
+    auto size = dimensions.empty() ? 0 : dimensions.front().size();
+    mask.assign(size - begin, 0);
+
+    std::size_t position = begin;
+    for (; position + 8 <= size; position += 8) {
+
+        // the lanes of the boxes that overlap in all dimensions so far
+        unsigned lanes = 0xFF;
+        for (std::size_t dimension = 0; dimension < dimensions.size() && lanes != 0; ++dimension) {
+            const auto &columns = dimensions[dimension];
+            const auto &other_columns = other_dimensions[dimension];
+            const __m256 new_lower = _mm256_max_ps(_mm256_set1_ps(other_columns.lower[other_position]),
+                                                   _mm256_loadu_ps(columns.lower.data() + position));
+            const __m256 new_upper = _mm256_min_ps(_mm256_set1_ps(other_columns.upper[other_position]),
+                                                   _mm256_loadu_ps(columns.upper.data() + position));
+            auto overlapping = static_cast<unsigned>(_mm256_movemask_ps(
+                    _mm256_cmp_ps(new_lower, new_upper, _CMP_LT_OQ)));
+            auto touching = static_cast<unsigned>(_mm256_movemask_ps(
+                    _mm256_cmp_ps(new_lower, new_upper, _CMP_EQ_OQ))) & lanes & ~overlapping;
+
+            // only touching lanes need a look at the borders
+            while (touching != 0) {
+                auto lane = static_cast<std::size_t>(__builtin_ctz(touching));
+                touching &= touching - 1;
+                if (simple_intervals_overlap(columns, position + lane, other_columns, other_position)) {
+                    overlapping |= 1u << lane;
+                }
+            }
+            lanes &= overlapping;
+        }
+
+        for (std::size_t lane = 0; lane < 8; ++lane) {
+            mask[position - begin + lane] = static_cast<std::uint8_t>((lanes >> lane) & 1u);
+        }
+    }
+
+    for (; position < size; ++position) {
+        bool overlapping = true;
+        for (std::size_t dimension = 0; dimension < dimensions.size() && overlapping; ++dimension) {
+            overlapping = simple_intervals_overlap(dimensions[dimension], position, other_dimensions[dimension],
+                                                   other_position);
+        }
+        mask[position - begin] = overlapping;
+    }
+}
+#else
+void box_overlap_mask_avx2(const std::vector<SimpleIntervalColumns> &dimensions, std::size_t begin,
+                           const std::vector<SimpleIntervalColumns> &other_dimensions, std::size_t other_position,
+                           std::vector<std::uint8_t> &mask) {
+    box_overlap_mask_scalar(dimensions, begin, other_dimensions, other_position, mask);
+}
+#endif
+
+void ColumnarEvent::overlap_mask(const ColumnarEvent &other, std::size_t other_position, std::size_t begin,
+                                 std::vector<std::uint8_t> &mask) const {
+    if (avx2_available()) {
+        box_overlap_mask_avx2(dimensions, begin, other.dimensions, other_position, mask);
+    } else {
+        box_overlap_mask_scalar(dimensions, begin, other.dimensions, other_position, mask);
+    }
+}
+
+void ColumnarEvent::overlapping_boxes(const ColumnarEvent &other, std::size_t other_position,
+                                      std::vector<std::uint32_t> &positions) const {
+    check_variables(other);
+    std::vector<std::uint8_t> mask;
+    overlap_mask(other, other_position, 0, mask);
+    for (std::size_t position = 0; position < mask.size(); ++position) {
+        if (mask[position]) {
+            positions.push_back(static_cast<std::uint32_t>(position));
+        }
+    }
+}
+
+std::vector<IndexPair> ColumnarEvent::overlapping_pairs(const ColumnarEvent &other) const {
+    check_variables(other);
+    std::vector<IndexPair> result;
+    std::vector<std::uint8_t> mask;
+    for (std::size_t other_position = 0; other_position < other.size(); ++other_position) {
+        overlap_mask(other, other_position, 0, mask);
+        for (std::size_t position = 0; position < mask.size(); ++position) {
+            if (mask[position]) {
+                result.emplace_back(static_cast<std::uint32_t>(position),
+                                    static_cast<std::uint32_t>(other_position));
+            }
+        }
+    }
+    return result;
+}
+
+bool ColumnarEvent::intersects(const ColumnarEvent &other) const {
+    check_variables(other);
+    std::vector<std::uint8_t> mask;
+    for (std::size_t other_position = 0; other_position < other.size(); ++other_position) {
+        overlap_mask(other, other_position, 0, mask);
+        if (std::find(mask.begin(), mask.end(), 1) != mask.end()) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool ColumnarEvent::is_disjoint() const {
+    std::vector<std::uint8_t> mask;
+    for (std::size_t position = 0; position + 1 < size(); ++position) {
+        overlap_mask(*this, position, position + 1, mask);
+        if (std::find(mask.begin(), mask.end(), 1) != mask.end()) {
+            return false;
+        }
+    }
+    return true;
+}
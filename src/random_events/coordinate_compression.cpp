@@ -0,0 +1,445 @@
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <map>
+#include <stdexcept>
+#include "coordinate_compression.h"
+
+namespace {
+
+    std::size_t words_for(std::size_t cells) {
+        return (cells + 63) / 64;
+    }
+
+    GridSet full_grid_set(std::size_t cells) {
+        GridSet result(words_for(cells), ~std::uint64_t{0});
+        if (cells % 64 != 0) {
+            result.back() = (std::uint64_t{1} << (cells % 64)) - 1;
+        }
+        return result;
+    }
+
+    bool test_cell(const GridSet &cells, std::size_t cell) {
+        return (cells[cell / 64] >> (cell % 64)) & 1u;
+    }
+
+    /**
+     * Add the cells from first to last, both inclusive.
+     */
+    void add_cells(GridSet &cells, std::size_t first, std::size_t last) {
+        for (std::size_t cell = first; cell <= last; ++cell) {
+            cells[cell / 64] |= std::uint64_t{1} << (cell % 64);
+        }
+    }
+
+    bool is_empty_grid_set(const GridSet &cells) {
+        return std::all_of(cells.begin(), cells.end(), [](std::uint64_t word) {
+            return word == 0;
+        });
+    }
+
+    GridSet intersect_grid_sets(const GridSet &first, const GridSet &second) {
+        GridSet result(first.size());
+        for (std::size_t word = 0; word < first.size(); ++word) {
+            result[word] = first[word] & second[word];
+        }
+        return result;
+    }
+
+    GridSet subtract_grid_sets(const GridSet &first, const GridSet &second) {
+        GridSet result(first.size());
+        for (std::size_t word = 0; word < first.size(); ++word) {
+            result[word] = first[word] & ~second[word];
+        }
+        return result;
+    }
+
+    /**
+     * @return The intersection of two boxes or an empty box if they do not intersect.
+     */
+    GridBox intersect_boxes(const GridBox &first, const GridBox &second) {
+        GridBox result;
+        result.reserve(first.size());
+        for (std::size_t dimension = 0; dimension < first.size(); ++dimension) {
+            result.push_back(intersect_grid_sets(first[dimension], second[dimension]));
+            if (is_empty_grid_set(result.back())) {
+                return {};
+            }
+        }
+        return result;
+    }
+
+    /**
+     * Append the difference of two boxes as disjoint boxes, in the same way as `SimpleEvent::difference_with`:
+     * the i-th box takes the intersection in the dimensions before i, the difference in dimension i and the first box
+     * in the dimensions after i.
+     */
+    void subtract_boxes(const GridBox &first, const GridBox &second, std::vector<GridBox> &result) {
+        auto intersection = intersect_boxes(first, second);
+        if (intersection.empty() && !first.empty()) {
+            result.push_back(first);
+            return;
+        }
+        for (std::size_t dimension = 0; dimension < first.size(); ++dimension) {
+            auto difference = subtract_grid_sets(first[dimension], second[dimension]);
+            if (is_empty_grid_set(difference)) {
+                continue;
+            }
+            GridBox box(intersection.begin(), intersection.begin() + static_cast<std::ptrdiff_t>(dimension));
+            box.push_back(std::move(difference));
+            box.insert(box.end(), first.begin() + static_cast<std::ptrdiff_t>(dimension) + 1, first.end());
+            result.push_back(std::move(box));
+        }
+    }
+
+    /**
+     * @return The boxes without all boxes of other.
+     */
+    std::vector<GridBox> subtract_all(std::vector<GridBox> boxes, const std::vector<GridBox> &other) {
+        std::vector<GridBox> remainder;
+        for (const auto &other_box: other) {
+            remainder.clear();
+            for (const auto &box: boxes) {
+                subtract_boxes(box, other_box, remainder);
+            }
+            std::swap(boxes, remainder);
+            if (boxes.empty()) {
+                break;
+            }
+        }
+        return boxes;
+    }
+
+    std::size_t index_of(const std::vector<float> &endpoints, float value) {
+        auto position = std::lower_bound(endpoints.begin(), endpoints.end(), value);
+        if (position == endpoints.end() || *position != value) {
+            throw std::invalid_argument("The endpoint " + std::to_string(value) + " is not in the dictionary.");
+        }
+        return static_cast<std::size_t>(position - endpoints.begin());
+    }
+}
+
+GridBox CompressedEvent::full_box() const {
+    GridBox result;
+    result.reserve(cells.size());
+    for (auto dimension_cells: cells) {
+        result.push_back(full_grid_set(dimension_cells));
+    }
+    return result;
+}
+
+void CompressedEvent::check_grid(const CompressedEvent &other) const {
+    if (cells != other.cells) {
+        throw std::invalid_argument("Compressed events have to be on the same grid.");
+    }
+}
+
+CompressedEvent CompressedEvent::intersection_with(const CompressedEvent &other) const {
+    check_grid(other);
+    CompressedEvent result(cells);
+    for (const auto &box: boxes) {
+        for (const auto &other_box: other.boxes) {
+            auto intersection = intersect_boxes(box, other_box);
+            if (!intersection.empty()) {
+                result.boxes.push_back(std::move(intersection));
+            }
+        }
+    }
+    return result;
+}
+
+CompressedEvent CompressedEvent::difference_with(const CompressedEvent &other) const {
+    check_grid(other);
+    CompressedEvent result(cells);
+    result.boxes = subtract_all(boxes, other.boxes);
+    return result.simplify();
+}
+
+CompressedEvent CompressedEvent::union_with(const CompressedEvent &other) const {
+    check_grid(other);
+    CompressedEvent result(cells);
+    result.boxes = boxes;
+    auto remainder = subtract_all(other.boxes, boxes);
+    result.boxes.insert(result.boxes.end(), remainder.begin(), remainder.end());
+    return result.simplify();
+}
+
+CompressedEvent CompressedEvent::complement() const {
+    CompressedEvent result(cells);
+    result.boxes = subtract_all({full_box()}, boxes);
+    return result.simplify();
+}
+
+CompressedEvent CompressedEvent::make_disjoint() const {
+    CompressedEvent result(cells);
+    for (const auto &box: boxes) {
+        auto remainder = subtract_all({box}, result.boxes);
+        result.boxes.insert(result.boxes.end(), remainder.begin(), remainder.end());
+    }
+    return result.simplify();
+}
+
+CompressedEvent CompressedEvent::simplify() const {
+    CompressedEvent result = *this;
+    bool merged = true;
+    while (merged) {
+        merged = false;
+        for (std::size_t dimension = 0; dimension < cells.size(); ++dimension) {
+
+            // boxes with the same cells in all other dimensions are merged by uniting the cells of this dimension
+            std::map<GridBox, std::size_t> positions;
+            std::vector<GridBox> merged_boxes;
+            for (auto &box: result.boxes) {
+                auto cells_of_dimension = std::move(box[dimension]);
+                box[dimension].clear();
+                auto [position, inserted] = positions.insert({box, merged_boxes.size()});
+                if (inserted) {
+                    box[dimension] = std::move(cells_of_dimension);
+                    merged_boxes.push_back(std::move(box));
+                    continue;
+                }
+                auto &merged_cells = merged_boxes[position->second][dimension];
+                for (std::size_t word = 0; word < merged_cells.size(); ++word) {
+                    merged_cells[word] |= cells_of_dimension[word];
+                }
+                merged = true;
+            }
+            result.boxes = std::move(merged_boxes);
+        }
+    }
+    return result;
+}
+
+bool CompressedEvent::is_disjoint() const {
+    for (std::size_t i = 0; i < boxes.size(); ++i) {
+        for (std::size_t j = i + 1; j < boxes.size(); ++j) {
+            if (!intersect_boxes(boxes[i], boxes[j]).empty()) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+CoordinateCompression::CoordinateCompression(const std::vector<Event> &events) {
+    std::map<VisitVariableVariant, std::vector<float>> variable_endpoints;
+    for (const auto &event: events) {
+        for (const auto &simple_event: event.simple_sets) {
+            for (const auto &[variable, assignment]: simple_event.variable_assignments) {
+                auto &current_endpoints = variable_endpoints[variable];
+                if (!std::holds_alternative<Interval>(assignment)) {
+                    continue;
+                }
+                for (const auto &simple_interval: std::get<Interval>(assignment).simple_sets) {
+                    for (auto endpoint: {simple_interval.lower, simple_interval.upper}) {
+                        if (std::isfinite(endpoint)) {
+                            current_endpoints.push_back(endpoint);
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    for (auto &[variable, current_endpoints]: variable_endpoints) {
+        const auto &variable_variant = variable.variable_variant;
+        variables.push_back(variable);
+        if (std::holds_alternative<Symbolic>(variable_variant)) {
+            const auto &all_elements = std::get<Symbolic>(variable_variant).domain.all_elements;
+            endpoints.emplace_back();
+            elements.emplace_back(all_elements.begin(), all_elements.end());
+        } else if (std::holds_alternative<Continuous>(variable_variant) ||
+                   std::holds_alternative<Integer>(variable_variant)) {
+            std::sort(current_endpoints.begin(), current_endpoints.end());
+            current_endpoints.erase(std::unique(current_endpoints.begin(), current_endpoints.end()),
+                                    current_endpoints.end());
+            endpoints.push_back(std::move(current_endpoints));
+            elements.emplace_back();
+        } else {
+            throw std::invalid_argument("Cannot compress the assignments of an empty variable.");
+        }
+    }
+}
+
+std::vector<std::size_t> CoordinateCompression::cells() const {
+    std::vector<std::size_t> result;
+    result.reserve(variables.size());
+    for (std::size_t dimension = 0; dimension < variables.size(); ++dimension) {
+        result.push_back(elements[dimension].empty() ? 2 * endpoints[dimension].size() + 1
+                                                     : elements[dimension].size());
+    }
+    return result;
+}
+
+GridSet CoordinateCompression::compress_interval(std::size_t dimension, const Interval &interval) const {
+    const auto &dimension_endpoints = endpoints[dimension];
+    GridSet result(words_for(2 * dimension_endpoints.size() + 1), 0);
+    for (const auto &simple_interval: interval.simple_sets) {
+        if (simple_interval.is_empty()) {
+            continue;
+        }
+        std::size_t first = 0;
+        if (simple_interval.lower != -std::numeric_limits<float>::infinity()) {
+            auto index = index_of(dimension_endpoints, simple_interval.lower);
+            first = simple_interval.left == BorderType::CLOSED ? 2 * index + 1 : 2 * index + 2;
+        }
+        std::size_t last = 2 * dimension_endpoints.size();
+        if (simple_interval.upper != std::numeric_limits<float>::infinity()) {
+            auto index = index_of(dimension_endpoints, simple_interval.upper);
+            last = simple_interval.right == BorderType::CLOSED ? 2 * index + 1 : 2 * index;
+        }
+        if (first <= last) {
+            add_cells(result, first, last);
+        }
+    }
+    return result;
+}
+
+GridSet CoordinateCompression::compress_set(std::size_t dimension, const Set &set) const {
+    const auto &dimension_elements = elements[dimension];
+    GridSet result(words_for(dimension_elements.size()), 0);
+    for (const auto &simple_set: set.simple_sets) {
+        auto position = std::lower_bound(dimension_elements.begin(), dimension_elements.end(), simple_set.element);
+        if (position == dimension_elements.end() || *position != simple_set.element) {
+            throw std::invalid_argument("The element " + simple_set.element + " is not in the dictionary.");
+        }
+        auto cell = static_cast<std::size_t>(position - dimension_elements.begin());
+        add_cells(result, cell, cell);
+    }
+    return result;
+}
+
+CompressedEvent CoordinateCompression::compress(const Event &event) const {
+    CompressedEvent result(cells());
+    for (const auto &simple_event: event.simple_sets) {
+        for (const auto &[variable, assignment]: simple_event.variable_assignments) {
+            if (!std::binary_search(variables.begin(), variables.end(), variable)) {
+                throw std::invalid_argument("The event assigns a variable that is not in the dictionary.");
+            }
+        }
+
+        GridBox box;
+        box.reserve(variables.size());
+        bool empty_box = false;
+        for (std::size_t dimension = 0; dimension < variables.size() && !empty_box; ++dimension) {
+            auto assignment = simple_event.variable_assignments.find(variables[dimension]);
+            if (assignment == simple_event.variable_assignments.end() ||
+                std::holds_alternative<std::monostate>(assignment->second)) {
+                box.push_back(full_grid_set(result.cells[dimension]));
+            } else if (std::holds_alternative<Interval>(assignment->second)) {
+                box.push_back(compress_interval(dimension, std::get<Interval>(assignment->second)));
+            } else {
+                box.push_back(compress_set(dimension, std::get<Set>(assignment->second)));
+            }
+            empty_box = is_empty_grid_set(box.back());
+        }
+        if (!empty_box) {
+            result.boxes.push_back(std::move(box));
+        }
+    }
+    return result;
+}
+
+Interval CoordinateCompression::decompress_interval(std::size_t dimension, const GridSet &cells) const {
+    const auto &dimension_endpoints = endpoints[dimension];
+    const auto number_of_cells = 2 * dimension_endpoints.size() + 1;
+    const auto infinity = std::numeric_limits<float>::infinity();
+
+    SimpleSetType<SimpleInterval> result;
+    for (std::size_t first = 0; first < number_of_cells; ++first) {
+        if (!test_cell(cells, first)) {
+            continue;
+        }
+
+        // every run of cells is a simple interval
+        auto last = first;
+        while (last + 1 < number_of_cells && test_cell(cells, last + 1)) {
+            ++last;
+        }
+
+        float lower;
+        BorderType left;
+        if (first % 2 == 1) {
+            lower = dimension_endpoints[first / 2];
+            left = BorderType::CLOSED;
+        } else {
+            lower = first == 0 ? -infinity : dimension_endpoints[first / 2 - 1];
+            left = BorderType::OPEN;
+        }
+
+        float upper;
+        BorderType right;
+        if (last % 2 == 1) {
+            upper = dimension_endpoints[last / 2];
+            right = BorderType::CLOSED;
+        } else {
+            upper = last == number_of_cells - 1 ? infinity : dimension_endpoints[last / 2];
+            right = BorderType::OPEN;
+        }
+
+        result.insert(result.end(), SimpleInterval(lower, upper, left, right));
+        first = last;
+    }
+    return Interval(result);
+}
+
+Set CoordinateCompression::decompress_set(std::size_t dimension, const GridSet &cells) const {
+    const auto &all_elements = std::get<Symbolic>(variables[dimension].variable_variant).domain.all_elements;
+    SimpleSetType<SimpleSet> result;
+    for (std::size_t cell = 0; cell < elements[dimension].size(); ++cell) {
+        if (test_cell(cells, cell)) {
+            result.insert(result.end(), SimpleSet(elements[dimension][cell], all_elements));
+        }
+    }
+    return Set(result, all_elements);
+}
+
+Event CoordinateCompression::decompress(const CompressedEvent &event) const {
+    Event result;
+    for (const auto &box: event.boxes) {
+        VariableAssignmentType assignments;
+        for (std::size_t dimension = 0; dimension < variables.size(); ++dimension) {
+            if (elements[dimension].empty()) {
+                assignments.insert({variables[dimension], decompress_interval(dimension, box[dimension])});
+            } else {
+                assignments.insert({variables[dimension], decompress_set(dimension, box[dimension])});
+            }
+        }
+        result.simple_sets.insert(SimpleEvent(assignments));
+    }
+    return result;
+}
+
+double CoordinateCompression::measure(const CompressedEvent &event) const {
+    const auto infinity = std::numeric_limits<double>::infinity();
+    double result = 0;
+    for (const auto &box: event.boxes) {
+        double box_measure = 1;
+        for (std::size_t dimension = 0; dimension < variables.size(); ++dimension) {
+            double dimension_measure = 0;
+            if (!elements[dimension].empty()) {
+                for (std::size_t cell = 0; cell < elements[dimension].size(); ++cell) {
+                    dimension_measure += test_cell(box[dimension], cell);
+                }
+            } else {
+
+                // only the gaps between the points have a length
+                const auto &dimension_endpoints = endpoints[dimension];
+                for (std::size_t gap = 0; gap <= dimension_endpoints.size(); ++gap) {
+                    if (!test_cell(box[dimension], 2 * gap)) {
+                        continue;
+                    }
+                    if (gap == 0 || gap == dimension_endpoints.size()) {
+                        dimension_measure = infinity;
+                        break;
+                    }
+                    dimension_measure += static_cast<double>(dimension_endpoints[gap]) -
+                                         dimension_endpoints[gap - 1];
+                }
+            }
+            box_measure *= dimension_measure;
+        }
+        result += box_measure;
+    }
+    return result;
+}
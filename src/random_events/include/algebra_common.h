@@ -34,3 +34,128 @@ struct VisitSetVariant {
 
 
 };
+
+/**
+ * Check if a set variant is empty.
+ * The monostate is considered empty.
+ *
+ * @param set_variant The set variant.
+ * @return True if the set variant is empty.
+ */
+inline bool set_variant_is_empty(const SetVariant &set_variant) {
+    if (std::holds_alternative<Interval>(set_variant)) {
+        return std::get<Interval>(set_variant).is_empty();
+    }
+    if (std::holds_alternative<Set>(set_variant)) {
+        return std::get<Set>(set_variant).is_empty();
+    }
+    return true;
+}
+
+/**
+ * Intersect two set variants of the same type.
+ *
+ * @param first The first set variant.
+ * @param second The second set variant.
+ * @return The intersection of both.
+ */
+inline SetVariant intersect_set_variants(const SetVariant &first, const SetVariant &second) {
+    if (std::holds_alternative<Interval>(first) && std::holds_alternative<Interval>(second)) {
+        return std::get<Interval>(first).intersection_with(std::get<Interval>(second));
+    }
+    if (std::holds_alternative<Set>(first) && std::holds_alternative<Set>(second)) {
+        return std::get<Set>(first).intersection_with(std::get<Set>(second));
+    }
+    throw std::invalid_argument("Only set variants of the same type can be intersected.");
+}
+
+/**
+ * Form the difference of two set variants of the same type.
+ *
+ * @param first The set variant to remove from.
+ * @param second The set variant to remove.
+ * @return The difference as disjoint set variant.
+ */
+inline SetVariant difference_of_set_variants(const SetVariant &first, const SetVariant &second) {
+    if (std::holds_alternative<Interval>(first) && std::holds_alternative<Interval>(second)) {
+        return std::get<Interval>(first).difference_with(std::get<Interval>(second));
+    }
+    if (std::holds_alternative<Set>(first) && std::holds_alternative<Set>(second)) {
+        return std::get<Set>(first).difference_with(std::get<Set>(second));
+    }
+    throw std::invalid_argument("Only set variants of the same type can be subtracted.");
+}
+
+/**
+ * Form the complement of an interval within the real line.
+ *
+ * @param interval The interval.
+ * @return The complement as disjoint interval.
+ */
+inline Interval complement_within_domain(const Interval &interval) {
+    return interval.is_empty() ? reals() : interval.complement();
+}
+
+/**
+ * Form the complement of a set within its elementary events, which is the entire domain if the set is empty.
+ *
+ * @param set The set.
+ * @return The complement as disjoint set.
+ */
+inline Set complement_within_domain(const Set &set) {
+    if (!set.is_empty()) {
+        return set.complement();
+    }
+    SimpleSetType<SimpleSet> elements;
+    for (const auto &element: set.all_elements) {
+        elements.insert(SimpleSet(element, set.all_elements));
+    }
+    return Set(elements, set.all_elements);
+}
+
+/**
+ * Form the complement of a set variant within the domain of its variable, which is the real line for intervals and the
+ * elements of the set for sets. The domain is never constructed.
+ *
+ * @param set_variant The set variant.
+ * @return The complement as disjoint set variant.
+ */
+inline SetVariant complement_of_set_variant(const SetVariant &set_variant) {
+    if (std::holds_alternative<Interval>(set_variant)) {
+        return complement_within_domain(std::get<Interval>(set_variant));
+    }
+    if (std::holds_alternative<Set>(set_variant)) {
+        return complement_within_domain(std::get<Set>(set_variant));
+    }
+    throw std::invalid_argument("Only intervals and sets can be complemented.");
+}
+
+/**
+ * Form the union of two set variants of the same type.
+ *
+ * @param first The first set variant.
+ * @param second The second set variant.
+ * @return The union as disjoint set variant.
+ */
+inline SetVariant union_of_set_variants(const SetVariant &first, const SetVariant &second) {
+    if (std::holds_alternative<Interval>(first) && std::holds_alternative<Interval>(second)) {
+        return std::get<Interval>(first).union_with(std::get<Interval>(second));
+    }
+    if (std::holds_alternative<Set>(first) && std::holds_alternative<Set>(second)) {
+        return std::get<Set>(first).union_with(std::get<Set>(second));
+    }
+    throw std::invalid_argument("Only set variants of the same type can be united.");
+}
+
+/**
+ * @return A string representation of a set variant.
+ */
+inline std::string set_variant_to_string(const SetVariant &set_variant) {
+    if (std::holds_alternative<Interval>(set_variant)) {
+        return std::get<Interval>(set_variant).to_string();
+    }
+    if (std::holds_alternative<Set>(set_variant)) {
+        return std::get<Set>(set_variant).to_string();
+    }
+    return "∅";
+}
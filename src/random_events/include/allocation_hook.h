@@ -0,0 +1,44 @@
+#pragma once
+
+#include <cstddef>
+
+/**
+ * Global allocation accounting.
+ *
+ * These functions are provided by the `random_events_allocation_hook` library, which replaces the global
+ * `operator new` and `operator delete`, including their nothrow and `std::align_val_t` overloads. Programs that link it can track the heap memory of events that are built
+ * or copied, e.g. to evict cached events by their actual size.
+ */
+
+/**
+ * Function that is called with the number of bytes of every allocation (positive) and deallocation (negative).
+ */
+using AllocationHook = void (*)(std::ptrdiff_t bytes);
+
+/**
+ * Install a hook that is called on every allocation and deallocation or remove it by passing a nullptr.
+ * The hook must not allocate itself.
+ *
+ * @return The previously installed hook.
+ */
+AllocationHook set_allocation_hook(AllocationHook hook);
+
+/**
+ * @return The number of bytes that are currently allocated through the global operator new.
+ */
+std::size_t allocated_bytes();
+
+/**
+ * @return The total number of allocations through the global operator new since the program started.
+ */
+std::size_t allocation_count();
+
+/**
+ * @return The total number of allocations by the calling thread since it started.
+ */
+std::size_t thread_allocation_count();
+
+/**
+ * @return The total number of bytes allocated by the calling thread since it started, ignoring deallocations.
+ */
+std::size_t thread_allocated_bytes();
@@ -0,0 +1,101 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include "overlap_kernel.h"
+#include "product_algebra.h"
+
+/*
+ * The structs of the Arrow C data interface as defined by its specification, which are all that is needed to exchange
+ * data with Arrow implementations without depending on any of them.
+ */
+#ifndef ARROW_C_DATA_INTERFACE
+#define ARROW_C_DATA_INTERFACE
+
+#define ARROW_FLAG_DICTIONARY_ORDERED 1
+#define ARROW_FLAG_NULLABLE 2
+#define ARROW_FLAG_MAP_KEYS_SORTED 4
+
+extern "C" {
+
+struct ArrowSchema {
+    const char *format;
+    const char *name;
+    const char *metadata;
+    int64_t flags;
+    int64_t n_children;
+    struct ArrowSchema **children;
+    struct ArrowSchema *dictionary;
+    void (*release)(struct ArrowSchema *);
+    void *private_data;
+};
+
+struct ArrowArray {
+    int64_t length;
+    int64_t null_count;
+    int64_t offset;
+    int64_t n_buffers;
+    int64_t n_children;
+    const void **buffers;
+    struct ArrowArray **children;
+    struct ArrowArray *dictionary;
+    void (*release)(struct ArrowArray *);
+    void *private_data;
+};
+
+}
+
+#endif // ARROW_C_DATA_INTERFACE
+
+/*
+ * Export and import of intervals and events through the Arrow C data interface.
+ *
+ * Simple intervals are exported as struct array with the columns `lower` and `upper` of type float32 and `borders` of
+ * type uint8, which holds the bits `SimpleIntervalColumns::LEFT_CLOSED` and `SimpleIntervalColumns::RIGHT_CLOSED`.
+ * An event is a struct array with one row per box and one column per variable, named like the variable:
+ *  - continuous and integer variables are lists of simple intervals,
+ *  - symbolic variables are lists of int32 indices into a dictionary of the elements of their domain.
+ * A null entry means that the box does not assign the variable.
+ *
+ * Exporting fills a schema and an array that the consumer has to release with their release callbacks. Importing takes
+ * over the schema and the array and releases them, also if the data is rejected with a std::invalid_argument.
+ */
+
+/**
+ * Export simple interval columns. Their buffers are moved into the array without copying.
+ *
+ * @param columns The columns to export.
+ * @param schema The schema to fill.
+ * @param array The array to fill.
+ */
+void export_columns(SimpleIntervalColumns columns, ArrowSchema *schema, ArrowArray *array);
+
+/**
+ * Export the simple intervals of an interval in ascending order.
+ */
+void export_interval(const Interval &interval, ArrowSchema *schema, ArrowArray *array);
+
+/**
+ * Export the boxes of an event in the order of its simple sets.
+ */
+void export_event(const Event &event, ArrowSchema *schema, ArrowArray *array);
+
+/**
+ * Import simple interval columns in the layout of `export_columns`.
+ *
+ * @return The columns in the order of the array.
+ */
+SimpleIntervalColumns import_columns(ArrowSchema *schema, ArrowArray *array);
+
+/**
+ * Import an interval from simple interval columns. Empty simple intervals are dropped.
+ */
+Interval import_interval(ArrowSchema *schema, ArrowArray *array);
+
+/**
+ * Import an event in the layout of `export_event`.
+ *
+ * @param variables The variables that may occur in the event, which are looked up by the names of the columns.
+ * @return The event with one box per row.
+ */
+Event import_event(ArrowSchema *schema, ArrowArray *array, const std::vector<VisitVariableVariant> &variables);
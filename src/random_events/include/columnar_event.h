@@ -0,0 +1,140 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include "overlap_kernel.h"
+#include "product_algebra.h"
+
+/**
+ * Event whose boxes are stored as columns, with one column set of simple intervals per variable.
+ *
+ * Every box assigns exactly one simple interval to every variable, and the box at position i consists of the simple
+ * intervals at position i of all dimensions. Testing a box against many boxes therefore compares contiguous arrays of
+ * bounds dimension by dimension instead of looking up the assignments of every box, which is done with the AVX2
+ * instructions for eight boxes at once if the machine supports them.
+ *
+ * Only variables whose assignments are intervals, i.e. continuous and integer variables, can be stored.
+ */
+class ColumnarEvent {
+public:
+
+    /**
+     * The variables of the dimensions in ascending order.
+     */
+    std::vector<VisitVariableVariant> variables;
+
+    /**
+     * The simple intervals of all boxes per variable.
+     */
+    std::vector<SimpleIntervalColumns> dimensions;
+
+    ColumnarEvent() = default;
+
+    /**
+     * Construct an event without boxes.
+     *
+     * @param variables The variables of the dimensions.
+     */
+    explicit ColumnarEvent(const std::set<VisitVariableVariant> &variables);
+
+    /**
+     * Convert an event over the variables of its boxes.
+     * Boxes that assign intervals with more than one simple interval are split into one box per combination of
+     * simple intervals, such that a disjoint event stays disjoint.
+     *
+     * @param event The event to convert.
+     */
+    explicit ColumnarEvent(const Event &event);
+
+    /**
+     * Convert an event over the given variables. Variables that a box does not assign take the real line.
+     *
+     * @param event The event to convert.
+     * @param variables The variables of the dimensions. They have to contain the variables of all boxes.
+     */
+    ColumnarEvent(const Event &event, const std::set<VisitVariableVariant> &variables);
+
+    /**
+     * Append a simple event, which is split into one box per combination of simple intervals.
+     *
+     * @param simple_event The simple event to append.
+     */
+    void push_back(const SimpleEvent &simple_event);
+
+    /**
+     * @return The box at the given position.
+     */
+    [[nodiscard]] SimpleEvent box(std::size_t position) const;
+
+    /**
+     * @return The event with one simple event per box.
+     */
+    [[nodiscard]] Event to_event() const;
+
+    /**
+     * @return The number of boxes.
+     */
+    [[nodiscard]] std::size_t size() const;
+
+    /**
+     * Check if a box of this and a box of another columnar event over the same variables overlap.
+     */
+    [[nodiscard]] bool boxes_overlap(std::size_t position, const ColumnarEvent &other,
+                                     std::size_t other_position) const;
+
+    /**
+     * Find the boxes of this that overlap a box of another columnar event over the same variables.
+     *
+     * @param other The other columnar event.
+     * @param other_position The position of the box in the other event.
+     * @param positions The vector to append the positions of the overlapping boxes of this to in ascending order.
+     */
+    void overlapping_boxes(const ColumnarEvent &other, std::size_t other_position,
+                           std::vector<std::uint32_t> &positions) const;
+
+    /**
+     * Find all pairs of overlapping boxes of this and another columnar event over the same variables.
+     *
+     * @return The pairs of positions in this and in the other event, ordered by the position in the other event.
+     */
+    [[nodiscard]] std::vector<IndexPair> overlapping_pairs(const ColumnarEvent &other) const;
+
+    /**
+     * @return True if any box of this overlaps any box of another columnar event over the same variables.
+     */
+    [[nodiscard]] bool intersects(const ColumnarEvent &other) const;
+
+    /**
+     * @return True if no two boxes of this overlap.
+     */
+    [[nodiscard]] bool is_disjoint() const;
+
+private:
+
+    /**
+     * Throw if the other event is not over the same variables.
+     */
+    void check_variables(const ColumnarEvent &other) const;
+
+    /**
+     * Mark the boxes of this from begin to the end that overlap a box of another event.
+     *
+     * @param mask The vector to store one byte per box of this in, which is 1 if the boxes overlap.
+     */
+    void overlap_mask(const ColumnarEvent &other, std::size_t other_position, std::size_t begin,
+                      std::vector<std::uint8_t> &mask) const;
+};
+
+/**
+ * Scalar variant of the test of a box against many boxes by `ColumnarEvent`.
+ */
+void box_overlap_mask_scalar(const std::vector<SimpleIntervalColumns> &dimensions, std::size_t begin,
+                             const std::vector<SimpleIntervalColumns> &other_dimensions, std::size_t other_position,
+                             std::vector<std::uint8_t> &mask);
+
+/**
+ * AVX2 variant of `box_overlap_mask_scalar`. It must only be called if `avx2_available()` is true.
+ */
+void box_overlap_mask_avx2(const std::vector<SimpleIntervalColumns> &dimensions, std::size_t begin,
+                           const std::vector<SimpleIntervalColumns> &other_dimensions, std::size_t other_position,
+                           std::vector<std::uint8_t> &mask);
@@ -0,0 +1,180 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "product_algebra.h"
+
+/**
+ * Subset of the cells of one dimension of a grid, stored as bits.
+ */
+using GridSet = std::vector<std::uint64_t>;
+
+/**
+ * Box on a grid with one set of cells per dimension.
+ */
+using GridBox = std::vector<GridSet>;
+
+/**
+ * Event on a grid of integer coordinates as produced by `CoordinateCompression`.
+ *
+ * Every dimension of a box is a set of cells, such that the operations of the product algebra reduce to bitwise
+ * operations on the cells of every dimension, which are exact and do not compare any floats. The results of all
+ * operations are disjoint if their operands are.
+ */
+class CompressedEvent {
+public:
+
+    /**
+     * The number of cells per dimension.
+     */
+    std::vector<std::size_t> cells;
+
+    /**
+     * The boxes of the event, which assign a non-empty set of cells to every dimension.
+     */
+    std::vector<GridBox> boxes;
+
+    CompressedEvent() = default;
+
+    /**
+     * Construct an event without boxes on a grid.
+     *
+     * @param cells The number of cells per dimension.
+     */
+    explicit CompressedEvent(std::vector<std::size_t> cells) : cells(std::move(cells)) {}
+
+    [[nodiscard]] bool is_empty() const {
+        return boxes.empty();
+    }
+
+    /**
+     * @return The box that contains all cells.
+     */
+    [[nodiscard]] GridBox full_box() const;
+
+    /**
+     * @return The intersection with another event on the same grid.
+     */
+    [[nodiscard]] CompressedEvent intersection_with(const CompressedEvent &other) const;
+
+    /**
+     * Form the difference with another event on the same grid by removing its boxes one after another.
+     *
+     * @return The simplified difference.
+     */
+    [[nodiscard]] CompressedEvent difference_with(const CompressedEvent &other) const;
+
+    /**
+     * Form the union with another event on the same grid by adding its boxes without this.
+     * Both events have to be disjoint.
+     *
+     * @return The simplified union.
+     */
+    [[nodiscard]] CompressedEvent union_with(const CompressedEvent &other) const;
+
+    /**
+     * @return The simplified complement.
+     */
+    [[nodiscard]] CompressedEvent complement() const;
+
+    /**
+     * Make the boxes disjoint by adding one box after another without the boxes added so far.
+     *
+     * @return The simplified disjoint event.
+     */
+    [[nodiscard]] CompressedEvent make_disjoint() const;
+
+    /**
+     * Merge the boxes that have the same cells in all but one dimension until no more boxes can be merged.
+     *
+     * @return The simplified event.
+     */
+    [[nodiscard]] CompressedEvent simplify() const;
+
+    /**
+     * @return True if no two boxes intersect.
+     */
+    [[nodiscard]] bool is_disjoint() const;
+
+    bool operator==(const CompressedEvent &other) const {
+        return cells == other.cells && boxes == other.boxes;
+    }
+
+private:
+    void check_grid(const CompressedEvent &other) const;
+};
+
+/**
+ * Dictionary of the endpoints of many events per variable, which maps boxes to a common grid of integer coordinates.
+ *
+ * The sorted distinct finite endpoints v_0 < ... < v_{n-1} of a continuous or integer variable cut the real line into
+ * 2n + 1 cells: the cell 2i + 1 is the point v_i and the cell 2i is the open gap between v_{i-1} and v_i, where the
+ * gaps 0 and 2n reach to negative and positive infinity. A simple interval is then the range of cells from its lower
+ * to its upper rank, where a closed border takes the odd rank of the point and an open border the even rank of the
+ * gap next to it. The cells of a symbolic variable are the elements of its domain in ascending order.
+ *
+ * Workloads of many events that share few distinct endpoints can compress all events once, run their set operations
+ * on the grid with `CompressedEvent` and decompress the results.
+ */
+class CoordinateCompression {
+public:
+
+    /**
+     * The variables of the dimensions in ascending order.
+     */
+    std::vector<VisitVariableVariant> variables;
+
+    /**
+     * The sorted distinct finite endpoints per dimension, which are empty for symbolic variables.
+     */
+    std::vector<std::vector<float>> endpoints;
+
+    /**
+     * The sorted elements of the domain per dimension, which are empty for continuous and integer variables.
+     */
+    std::vector<std::vector<std::string>> elements;
+
+    /**
+     * Build the dictionary of the variables and endpoints of some events.
+     *
+     * @param events The events whose boxes are compressed later.
+     */
+    explicit CoordinateCompression(const std::vector<Event> &events);
+
+    /**
+     * @return The number of cells per dimension.
+     */
+    [[nodiscard]] std::vector<std::size_t> cells() const;
+
+    /**
+     * Map the boxes of an event to the grid. Variables that a box does not assign take all their cells.
+     *
+     * @param event The event, whose variables and endpoints have to be in the dictionary.
+     * @return The compressed event with one box per box of the event.
+     */
+    [[nodiscard]] CompressedEvent compress(const Event &event) const;
+
+    /**
+     * Map the boxes of a compressed event back to simple intervals and sets.
+     *
+     * @param event The compressed event.
+     * @return The event with one box per box of the compressed event.
+     */
+    [[nodiscard]] Event decompress(const CompressedEvent &event) const;
+
+    /**
+     * @return The sum of the measures of the boxes of a compressed event, which is the measure of `SimpleEvent` of
+     * the decompressed boxes in the space of the variables of this compression.
+     */
+    [[nodiscard]] double measure(const CompressedEvent &event) const;
+
+private:
+    [[nodiscard]] GridSet compress_interval(std::size_t dimension, const Interval &interval) const;
+
+    [[nodiscard]] GridSet compress_set(std::size_t dimension, const Set &set) const;
+
+    [[nodiscard]] Interval decompress_interval(std::size_t dimension, const GridSet &cells) const;
+
+    [[nodiscard]] Set decompress_set(std::size_t dimension, const GridSet &cells) const;
+};
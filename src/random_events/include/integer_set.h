@@ -0,0 +1,136 @@
+#pragma once
+
+#include <cstdint>
+#include <initializer_list>
+#include <utility>
+#include <variant>
+#include <vector>
+#include "interval.h"
+
+/**
+ * Sorted values of a chunk for sparse chunks.
+ */
+struct ArrayContainer {
+    std::vector<std::uint16_t> values;
+};
+
+/**
+ * One bit per value of a chunk for dense chunks.
+ */
+struct BitmapContainer {
+    static constexpr std::size_t WORDS = (1u << 16) / 64;
+
+    std::vector<std::uint64_t> words = std::vector<std::uint64_t>(WORDS, 0);
+    std::uint32_t cardinality = 0;
+};
+
+/**
+ * Maximal runs of consecutive values of a chunk for clustered chunks.
+ * Every run is stored as its first value and its length minus one.
+ */
+struct RunContainer {
+    std::vector<std::pair<std::uint16_t, std::uint16_t>> runs;
+};
+
+using IntegerContainer = std::variant<ArrayContainer, BitmapContainer, RunContainer>;
+
+/**
+ * Enum for the representation of a chunk of an integer set.
+ */
+enum class ContainerKind {
+    ARRAY,
+    BITMAP,
+    RUN
+};
+
+/**
+ * Compressed set of 32-bit integers for the values of integer variables, in the style of roaring bitmaps.
+ *
+ * The integers are split into chunks of 2^16 consecutive values by their upper 16 bits. Every non-empty chunk is
+ * stored in the smallest of three containers: a sorted array of at most 4096 values, a bitmap of 8 KiB or a list of
+ * runs. Set operations work chunk by chunk with word-wise operations on bitmaps and merges on arrays and runs, and
+ * every resulting chunk is stored in its smallest container again.
+ *
+ * Integer variables still hold intervals in events, since the product algebra is built on SetType. An integer set is
+ * a companion representation: large sets of integers are built and combined here and converted with `from_interval`
+ * and `to_interval` where they meet events.
+ */
+class IntegerSet {
+public:
+
+    IntegerSet() = default;
+
+    IntegerSet(std::initializer_list<std::int32_t> values);
+
+    /**
+     * @return The set of all integers from first to last, both included.
+     */
+    static IntegerSet range(std::int32_t first, std::int32_t last);
+
+    /**
+     * Construct the set of all integers within an interval.
+     *
+     * @param interval The interval, which has to be bounded and within the range of 32-bit integers.
+     * @return The integers within the interval.
+     */
+    static IntegerSet from_interval(const Interval &interval);
+
+    /**
+     * @return The interval that consists of one closed simple interval per maximal run of consecutive integers.
+     * @throws std::invalid_argument If the first or last integer of a run cannot be represented exactly as float,
+     * which may be the case for integers beyond 2^24 in magnitude.
+     */
+    [[nodiscard]] Interval to_interval() const;
+
+    void insert(std::int32_t value);
+
+    [[nodiscard]] bool contains(std::int32_t value) const;
+
+    [[nodiscard]] bool is_empty() const {
+        return chunks.empty();
+    }
+
+    /**
+     * @return The number of integers in this set.
+     */
+    [[nodiscard]] std::uint64_t cardinality() const;
+
+    /**
+     * @return The number of integers in this set that are smaller than or equal to value.
+     */
+    [[nodiscard]] std::uint64_t rank(std::int32_t value) const;
+
+    [[nodiscard]] IntegerSet union_with(const IntegerSet &other) const;
+
+    [[nodiscard]] IntegerSet intersection_with(const IntegerSet &other) const;
+
+    [[nodiscard]] IntegerSet difference_with(const IntegerSet &other) const;
+
+    /**
+     * @return The integers of this set in ascending order.
+     */
+    [[nodiscard]] std::vector<std::int32_t> to_vector() const;
+
+    /**
+     * @return The representation of every chunk in ascending order of the chunks.
+     */
+    [[nodiscard]] std::vector<ContainerKind> container_kinds() const;
+
+    /**
+     * @return The heap memory of the chunks and their containers.
+     */
+    [[nodiscard]] MemoryFootprint memory_footprint() const;
+
+    bool operator==(const IntegerSet &other) const;
+
+    bool operator!=(const IntegerSet &other) const {
+        return !(*this == other);
+    }
+
+private:
+
+    /**
+     * The non-empty chunks sorted by the upper 16 bits of their values.
+     */
+    std::vector<std::pair<std::uint16_t, IntegerContainer>> chunks;
+};
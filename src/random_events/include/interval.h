@@ -2,11 +2,14 @@
 
 #include "sigma_algebra.h"
 #include <unordered_set>
+#include <limits>
+#include <cstdint>
+#include <type_traits>
 
 /**
  * Enum for border types of simple_sets.
  */
-enum class BorderType {
+enum class BorderType : std::uint8_t {
 
     /**
      * Open indicates that a value is included in the interval.
@@ -43,28 +46,31 @@ class Interval; // Forward declaration
 
 /**
  * Class that represents an atomic interval.
+ *
+ * Simple intervals are plain, trivially copyable values without a vtable. Both borders are packed into one byte,
+ * such that arrays of simple intervals can be copied with `memcpy` or placed in shared memory.
  */
 class SimpleInterval : public SimpleSetWrapper<Interval, SimpleInterval, float> {
 public:
     /**
      * The lower value.
      */
-    float lower = 0;
+    float lower;
 
     /**
      * The upper value.
      */
-    float upper = 0;
+    float upper;
 
     /**
      * THe left border type.
      */
-    BorderType left = BorderType::OPEN;
+    BorderType left: 1;
 
     /**
      * The right border type.
      */
-    BorderType right = BorderType::OPEN;
+    BorderType right: 1;
 
     /**
      * Construct an atomic interval.
@@ -81,6 +87,13 @@ public:
 
     [[nodiscard]] bool simple_set_is_empty() const;
 
+    /**
+     * @return Nothing, since simple intervals do not hold heap memory.
+     */
+    [[nodiscard]] MemoryFootprint simple_set_memory_footprint() const {
+        return {};
+    }
+
     /**
      * This method depends on the type of simple set and has to be overloaded.
      *
@@ -89,21 +102,27 @@ public:
      */
     bool operator==(const SimpleInterval &other) const;
 
-    std::string to_string();
+    [[nodiscard]] std::string to_string() const;
 
-    explicit operator std::string();
+    explicit operator std::string() const;
 
     /**
      * Compare two simple intervals. Simple intervals are ordered by lower bound. If the lower bound is equal, they are
-     * ordered by upper bound.
+     * ordered by upper bound. Ties are broken by the borders, such that the ordering is consistent with equality.
      * @param other The other interval
      * @return True if this interval is less than the other interval.
      */
-    bool operator<(const SimpleInterval &other) const override {
-        if (lower == other.lower) {
+    bool operator<(const SimpleInterval &other) const {
+        if (lower != other.lower) {
+            return lower < other.lower;
+        }
+        if (upper != other.upper) {
             return upper < other.upper;
         }
-        return lower < other.lower;
+        if (left != other.left) {
+            return left == BorderType::CLOSED;
+        }
+        return right == BorderType::OPEN && other.right == BorderType::CLOSED;
     }
 
     /**
@@ -112,15 +131,16 @@ public:
     * @param other The other interval
     * @return True if this interval is less or equal to the other interval.
     */
-    bool operator<=(const SimpleInterval &other) const override {
-        if (lower == other.lower) {
-            return upper <= other.upper;
-        }
-        return lower <= other.lower;
+    bool operator<=(const SimpleInterval &other) const {
+        return !(other < *this);
     }
 
 };
 
+static_assert(std::is_trivially_copyable_v<SimpleInterval>, "SimpleInterval has to be trivially copyable.");
+static_assert(std::is_standard_layout_v<SimpleInterval>, "SimpleInterval has to have standard layout.");
+static_assert(sizeof(SimpleInterval) == 12, "SimpleInterval has to consist of two floats and one byte of borders.");
+
 /**
  * Hash function for simple intervals.
  */
@@ -146,6 +166,14 @@ void extend_vector(std::vector<T> &first, const std::vector<T> &second) {
     first.insert(first.end(), second.begin(), second.end());
 }
 
+/**
+ * The bounding hull of an interval is the smallest simple interval that contains it.
+ */
+template<>
+struct BoundingHullType<SimpleInterval> {
+    using type = SimpleInterval;
+};
+
 /**
  * Class that represents a composite interval.
  * An interval is an (automatically simplified) union of simple simple_sets.
@@ -168,12 +196,109 @@ public:
 
     Interval composite_set_simplify();
 
+    using CompositeSetWrapper::intersection_with;
+
+    /**
+     * Form the intersection with another interval using the vectorized overlap kernel.
+     *
+     * The intersection is only disjoint if both intervals are disjoint.
+     *
+     * @param other The other interval.
+     * @return The intersection.
+     */
+    [[nodiscard]] Interval intersection_with(const Interval &other) const;
+
+    /**
+     * Find the pairs of simple intervals that intersect using the vectorized overlap kernel.
+     *
+     * @return For every simple interval the positions of the other simple intervals that it intersects.
+     */
+    [[nodiscard]] std::vector<std::vector<std::size_t>> overlapping_simple_sets() const;
+
+    /**
+     * Check if no two simple intervals intersect by a sweep over the simple intervals in ascending order, which
+     * compares every simple interval with the one that reaches furthest among its predecessors.
+     * Since the simple intervals are stored in order, this takes O(n) time and does not allocate.
+     *
+     * @return True if no two simple intervals intersect.
+     */
+    [[nodiscard]] bool is_disjoint() const;
+
+    /**
+     * The bounding hull is computed once and shared by all copies until the simple intervals are modified.
+     *
+     * @return The smallest simple interval that contains this, which is empty if this is empty.
+     */
+    [[nodiscard]] const SimpleInterval &bounding_hull() const;
+
+    /**
+     * @return True if the bounding hulls of this and another interval do not intersect.
+     */
+    [[nodiscard]] bool bounding_hulls_disjoint(const Interval &other) const;
+
+    /**
+     * @return True if the bounding hull of this contains the one of another interval.
+     */
+    [[nodiscard]] bool bounding_hull_contains(const Interval &other) const;
+
+    /**
+     * @return The sum of the lengths of the simple intervals.
+     */
+    [[nodiscard]] double measure() const;
+
+    /**
+     * Approximate this disjoint interval by a superset with fewer simple intervals.
+     *
+     * First, all gaps between neighbouring simple intervals that are shorter than epsilon are closed. Then the
+     * shortest remaining gaps are closed until at most max_pieces simple intervals remain.
+     *
+     * @param max_pieces The maximum number of simple intervals of the result. It has to be positive.
+     * @param epsilon The length below which gaps are always closed.
+     * @return The coarsened interval and the measure that was added by closing gaps.
+     */
+    [[nodiscard]] std::tuple<Interval, double> coarsen(std::size_t max_pieces, float epsilon = 0) const;
+
     /**
      * The empty simple interval.
      */
     SimpleInterval simple_interval;
 };
 
+/**
+ * Hash function for intervals.
+ */
+namespace std {
+    template<>
+    struct hash<Interval> {
+        size_t operator()(const Interval &interval) const {
+            return interval.hash();
+        }
+    };
+}
+
+/**
+ * Form the union of many intervals at once.
+ *
+ * The simple intervals of all intervals are merged in ascending order with a heap of one cursor per interval, and
+ * overlapping or touching simple intervals are joined while merging. This takes O(n log k) time for n simple intervals
+ * in k intervals, instead of making the growing union disjoint k times.
+ *
+ * @param intervals The intervals to unite.
+ * @return The union as disjoint and simplified interval.
+ */
+Interval union_all(const std::vector<Interval> &intervals);
+
+/**
+ * Form the intersection of many intervals at once.
+ *
+ * The intervals are intersected pairwise, starting with the ones with the fewest simple intervals, by walking
+ * through both in ascending order. Intervals that are not disjoint are made disjoint first.
+ *
+ * @param intervals The intervals to intersect.
+ * @return The intersection as disjoint and simplified interval. The intersection of no intervals are the reals.
+ */
+Interval intersection_all(const std::vector<Interval> &intervals);
+
 inline Interval closed(float lower, float upper) {
     return Interval(
             SimpleSetType<SimpleInterval>{SimpleInterval{lower, upper, BorderType::CLOSED, BorderType::CLOSED}});
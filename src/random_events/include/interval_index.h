@@ -0,0 +1,96 @@
+#pragma once
+
+#include <vector>
+#include "interval.h"
+
+/**
+ * Index over many intervals that answers which of them contain a value.
+ *
+ * The index is a centered interval tree over the simple intervals of all indexed intervals. Every node stores the
+ * pieces that overlap its center once sorted by lower bound and once sorted by upper bound, such that a query visits
+ * O(log n) nodes and only touches the pieces it reports.
+ */
+class IntervalIndex {
+public:
+
+    IntervalIndex() = default;
+
+    /**
+     * Build the index over intervals. The id of an interval is its position in the vector.
+     * The intervals have to be disjoint, which is the case for the results of all set operations.
+     *
+     * @param intervals The intervals to index.
+     */
+    explicit IntervalIndex(const std::vector<Interval> &intervals);
+
+    /**
+     * Find the ids of all intervals that contain a value in O(log n + k).
+     *
+     * @param value The value to look up.
+     * @return The ids of the intervals that contain the value in no particular order.
+     */
+    [[nodiscard]] std::vector<std::size_t> stab(float value) const;
+
+    /**
+     * Append the ids of all intervals that contain a value to a result vector.
+     *
+     * @param value The value to look up.
+     * @param result The vector to append the ids to.
+     */
+    void stab(float value, std::vector<std::size_t> &result) const;
+
+    /**
+     * Find the ids of all intervals that contain a value for many values at once.
+     *
+     * @param values The values to look up.
+     * @return The ids of the intervals that contain the value for every value.
+     */
+    [[nodiscard]] std::vector<std::vector<std::size_t>> stab_all(const std::vector<float> &values) const;
+
+    /**
+     * @return The number of indexed intervals.
+     */
+    [[nodiscard]] std::size_t size() const {
+        return number_of_intervals;
+    }
+
+private:
+
+    /**
+     * A simple interval tagged with the id of the interval it belongs to.
+     */
+    struct Entry {
+        SimpleInterval simple_interval;
+        std::size_t id;
+    };
+
+    struct Node {
+        float center;
+
+        /**
+         * The pieces that overlap the center sorted by ascending lower bound.
+         */
+        std::vector<Entry> by_lower;
+
+        /**
+         * The pieces that overlap the center sorted by descending upper bound.
+         */
+        std::vector<Entry> by_upper;
+
+        /**
+         * The positions of the children in the node vector or -1 if absent.
+         */
+        std::ptrdiff_t left = -1;
+        std::ptrdiff_t right = -1;
+    };
+
+    /**
+     * Build the subtree for the given entries.
+     * @return The position of the root of the subtree.
+     */
+    std::ptrdiff_t build(std::vector<Entry> entries);
+
+    std::vector<Node> nodes;
+    std::ptrdiff_t root = -1;
+    std::size_t number_of_intervals = 0;
+};
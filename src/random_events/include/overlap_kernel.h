@@ -0,0 +1,92 @@
+#pragma once
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+#include "interval.h"
+
+/**
+ * Simple intervals stored as structure of arrays, such that many of them can be compared at once.
+ */
+struct SimpleIntervalColumns {
+
+    /**
+     * Bit of the borders that is set if the left border is closed.
+     */
+    static constexpr std::uint8_t LEFT_CLOSED = 1;
+
+    /**
+     * Bit of the borders that is set if the right border is closed.
+     */
+    static constexpr std::uint8_t RIGHT_CLOSED = 2;
+
+    std::vector<float> lower;
+    std::vector<float> upper;
+    std::vector<std::uint8_t> borders;
+
+    SimpleIntervalColumns() = default;
+
+    /**
+     * Construct the columns from the simple intervals of an interval in their order.
+     */
+    explicit SimpleIntervalColumns(const Interval &interval);
+
+    void push_back(const SimpleInterval &simple_interval);
+
+    /**
+     * @return The simple interval at the given position.
+     */
+    [[nodiscard]] SimpleInterval at(std::size_t position) const;
+
+    [[nodiscard]] std::size_t size() const {
+        return lower.size();
+    }
+
+    void reserve(std::size_t size);
+};
+
+/**
+ * Positions of two simple intervals.
+ */
+using IndexPair = std::pair<std::uint32_t, std::uint32_t>;
+
+/**
+ * @return True if the AVX2 kernels can be used on this machine.
+ */
+bool avx2_available();
+
+/**
+ * @return True if the simple interval at position i of first and the one at position j of second overlap.
+ */
+bool simple_intervals_overlap(const SimpleIntervalColumns &first, std::size_t i,
+                              const SimpleIntervalColumns &second, std::size_t j);
+
+/**
+ * Find all pairs of overlapping simple intervals from two column sets and append them to pairs.
+ * The pairs are ordered by the position in first and then by the position in second.
+ */
+void overlapping_pairs(const SimpleIntervalColumns &first, const SimpleIntervalColumns &second,
+                       std::vector<IndexPair> &pairs);
+
+/**
+ * Find all pairs (i, j) with i < j of overlapping simple intervals within one column set and append them to pairs.
+ */
+void overlapping_pairs_within(const SimpleIntervalColumns &columns, std::vector<IndexPair> &pairs);
+
+/**
+ * Append the non-empty intersections of all pairs of simple intervals from two column sets to result.
+ */
+void intersect_columns(const SimpleIntervalColumns &first, const SimpleIntervalColumns &second,
+                       SimpleIntervalColumns &result);
+
+/**
+ * Scalar variant of `overlapping_pairs`.
+ */
+void overlapping_pairs_scalar(const SimpleIntervalColumns &first, const SimpleIntervalColumns &second,
+                              std::vector<IndexPair> &pairs, bool only_upper_triangle = false);
+
+/**
+ * AVX2 variant of `overlapping_pairs`. It must only be called if `avx2_available()` is true.
+ */
+void overlapping_pairs_avx2(const SimpleIntervalColumns &first, const SimpleIntervalColumns &second,
+                            std::vector<IndexPair> &pairs, bool only_upper_triangle = false);
@@ -0,0 +1,318 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <unordered_set>
+#include <vector>
+#include "sigma_algebra.h"
+
+/**
+ * Persistent ordered set that is implemented as AVL tree with path copying.
+ *
+ * Every modification returns a new version and leaves this version unchanged. Only the O(log n) nodes on the path to
+ * the modified element are copied, while all other nodes are shared between the versions, such that the memory of
+ * many versions grows with the number of modifications instead of the number of versions times their size.
+ * Nodes are never modified after their construction, so every version may be read by any number of threads.
+ */
+template<typename T>
+class PersistentSet {
+private:
+
+    struct Node;
+    using NodePointer = std::shared_ptr<const Node>;
+
+    struct Node {
+        T value;
+        NodePointer left;
+        NodePointer right;
+        std::uint8_t height;
+        std::size_t size;
+    };
+
+public:
+    using value_type = T;
+
+    /**
+     * Forward iterator over the elements of a version in ascending order.
+     * It is valid as long as the version it was obtained from exists.
+     */
+    class const_iterator {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const T *;
+        using reference = const T &;
+
+        const_iterator() = default;
+
+        reference operator*() const {
+            return path.back()->value;
+        }
+
+        pointer operator->() const {
+            return &path.back()->value;
+        }
+
+        const_iterator &operator++() {
+            const Node *node = path.back();
+            if (node->right) {
+                push_leftmost(node->right.get());
+                return *this;
+            }
+
+            // go up until coming from a left child
+            path.pop_back();
+            while (!path.empty() && path.back()->right.get() == node) {
+                node = path.back();
+                path.pop_back();
+            }
+            return *this;
+        }
+
+        const_iterator operator++(int) {
+            auto result = *this;
+            ++*this;
+            return result;
+        }
+
+        bool operator==(const const_iterator &other) const {
+            return path == other.path;
+        }
+
+        bool operator!=(const const_iterator &other) const {
+            return path != other.path;
+        }
+
+    private:
+        friend class PersistentSet;
+
+        explicit const_iterator(const Node *root) {
+            push_leftmost(root);
+        }
+
+        void push_leftmost(const Node *node) {
+            while (node != nullptr) {
+                path.push_back(node);
+                node = node->left.get();
+            }
+        }
+
+        /**
+         * The nodes from the root to the current node.
+         */
+        std::vector<const Node *> path;
+    };
+
+    using iterator = const_iterator;
+
+    PersistentSet() = default;
+
+    /**
+     * Construct a balanced tree from the elements of a set in O(n) time.
+     */
+    explicit PersistentSet(const SimpleSetType<T> &values) {
+        std::vector<const T *> sorted;
+        sorted.reserve(values.size());
+        for (const auto &value: values) {
+            sorted.push_back(&value);
+        }
+        root = build(sorted, 0, sorted.size());
+    }
+
+    [[nodiscard]] const_iterator begin() const {
+        return const_iterator(root.get());
+    }
+
+    [[nodiscard]] const_iterator end() const {
+        return const_iterator();
+    }
+
+    [[nodiscard]] std::size_t size() const {
+        return size_of(root);
+    }
+
+    [[nodiscard]] bool empty() const {
+        return !root;
+    }
+
+    [[nodiscard]] bool contains(const T &value) const {
+        const Node *node = root.get();
+        while (node != nullptr) {
+            if (value < node->value) {
+                node = node->left.get();
+            } else if (node->value < value) {
+                node = node->right.get();
+            } else {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /**
+     * @return The version that additionally contains the value, which is this version if it contains it already.
+     */
+    [[nodiscard]] PersistentSet insert(const T &value) const {
+        if (contains(value)) {
+            return *this;
+        }
+        return PersistentSet(insert(root, value));
+    }
+
+    /**
+     * @return The version without the value, which is this version if it does not contain it.
+     */
+    [[nodiscard]] PersistentSet erase(const T &value) const {
+        if (!contains(value)) {
+            return *this;
+        }
+        return PersistentSet(erase(root, value));
+    }
+
+    /**
+     * @return The elements of this version as ordinary set.
+     */
+    [[nodiscard]] SimpleSetType<T> to_set() const {
+        SimpleSetType<T> result;
+        for (const auto &value: *this) {
+            result.insert(result.end(), value);
+        }
+        return result;
+    }
+
+    /**
+     * @return The height of the tree, which is at most 1.44 log2(n + 2).
+     */
+    [[nodiscard]] std::size_t height() const {
+        return height_of(root);
+    }
+
+    /**
+     * Count the nodes of several versions, where nodes that are shared between versions are counted once.
+     *
+     * @param versions The versions.
+     * @return The number of distinct nodes.
+     */
+    static std::size_t count_distinct_nodes(const std::vector<PersistentSet> &versions) {
+        std::unordered_set<const Node *> visited;
+        std::vector<const Node *> stack;
+        for (const auto &version: versions) {
+            if (version.root) {
+                stack.push_back(version.root.get());
+            }
+            while (!stack.empty()) {
+                const Node *node = stack.back();
+                stack.pop_back();
+                if (!visited.insert(node).second) {
+                    continue;
+                }
+                for (const Node *child: {node->left.get(), node->right.get()}) {
+                    if (child != nullptr) {
+                        stack.push_back(child);
+                    }
+                }
+            }
+        }
+        return visited.size();
+    }
+
+    bool operator==(const PersistentSet &other) const {
+        return root == other.root || (size() == other.size() && std::equal(begin(), end(), other.begin()));
+    }
+
+    bool operator!=(const PersistentSet &other) const {
+        return !(*this == other);
+    }
+
+private:
+
+    explicit PersistentSet(NodePointer root) : root(std::move(root)) {}
+
+    static std::uint8_t height_of(const NodePointer &node) {
+        return node ? node->height : 0;
+    }
+
+    static std::size_t size_of(const NodePointer &node) {
+        return node ? node->size : 0;
+    }
+
+    static NodePointer make_node(const T &value, NodePointer left, NodePointer right) {
+        auto height = static_cast<std::uint8_t>(1 + std::max(height_of(left), height_of(right)));
+        auto size = 1 + size_of(left) + size_of(right);
+        return std::make_shared<const Node>(Node{value, std::move(left), std::move(right), height, size});
+    }
+
+    /**
+     * Create a node whose subtrees differ in height by at most two and rotate it such that they differ by at most one.
+     */
+    static NodePointer balance(const T &value, NodePointer left, NodePointer right) {
+        if (height_of(left) > height_of(right) + 1) {
+            if (height_of(left->left) >= height_of(left->right)) {
+                return make_node(left->value, left->left, make_node(value, left->right, std::move(right)));
+            }
+            const auto &middle = left->right;
+            return make_node(middle->value, make_node(left->value, left->left, middle->left),
+                             make_node(value, middle->right, std::move(right)));
+        }
+        if (height_of(right) > height_of(left) + 1) {
+            if (height_of(right->right) >= height_of(right->left)) {
+                return make_node(right->value, make_node(value, std::move(left), right->left), right->right);
+            }
+            const auto &middle = right->left;
+            return make_node(middle->value, make_node(value, std::move(left), middle->left),
+                             make_node(right->value, middle->right, right->right));
+        }
+        return make_node(value, std::move(left), std::move(right));
+    }
+
+    static NodePointer insert(const NodePointer &node, const T &value) {
+        if (!node) {
+            return make_node(value, nullptr, nullptr);
+        }
+        if (value < node->value) {
+            return balance(node->value, insert(node->left, value), node->right);
+        }
+        return balance(node->value, node->left, insert(node->right, value));
+    }
+
+    static NodePointer erase_minimum(const NodePointer &node) {
+        if (!node->left) {
+            return node->right;
+        }
+        return balance(node->value, erase_minimum(node->left), node->right);
+    }
+
+    static NodePointer erase(const NodePointer &node, const T &value) {
+        if (value < node->value) {
+            return balance(node->value, erase(node->left, value), node->right);
+        }
+        if (node->value < value) {
+            return balance(node->value, node->left, erase(node->right, value));
+        }
+        if (!node->left) {
+            return node->right;
+        }
+        if (!node->right) {
+            return node->left;
+        }
+        const Node *minimum = node->right.get();
+        while (minimum->left) {
+            minimum = minimum->left.get();
+        }
+        return balance(minimum->value, node->left, erase_minimum(node->right));
+    }
+
+    static NodePointer build(const std::vector<const T *> &sorted, std::size_t begin, std::size_t end) {
+        if (begin == end) {
+            return nullptr;
+        }
+        auto middle = begin + (end - begin) / 2;
+        return make_node(*sorted[middle], build(sorted, begin, middle), build(sorted, middle + 1, end));
+    }
+
+    NodePointer root;
+};
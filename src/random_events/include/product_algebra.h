@@ -3,33 +3,107 @@
 #include "sigma_algebra.h"
 #include <map>
 #include <memory>
+#include <unordered_map>
 #include "variable.h"
 #include <variant>
-#include "variable.h"
+#include "algebra_common.h"
 
-using SetType = std::variant<std::monostate, Interval, Set>;
+using SetType = SetVariant;
 using VariableAssignmentType = std::map<VisitVariableVariant, SetType>;
 
+/**
+ * Hash function for variable assignments.
+ */
+namespace std {
+    template<>
+    struct hash<VariableAssignmentType> {
+        size_t operator()(const VariableAssignmentType &assignments) const {
+            size_t result = 0;
+            for (const auto &[variable, assignment]: assignments) {
+                result ^= hash<VisitVariableVariant>()(variable) + 0x9e3779b9 + (result << 6) + (result >> 2);
+                result ^= hash<SetType>()(assignment) + 0x9e3779b9 + (result << 6) + (result >> 2);
+            }
+            return result;
+        }
+    };
+}
+
 class Event; // Forward declaration
 
+/**
+ * Get the entire domain of a variable as set type.
+ *
+ * @param variable The variable.
+ * @return The domain of the variable where every element is part of the set.
+ */
+SetType full_domain_of(const VisitVariableVariant &variable);
+
+/**
+ * @return The heap memory held by a set variant.
+ */
+MemoryFootprint set_type_memory_footprint(const SetType &set);
+
+/**
+ * @return The heap memory held by a variable, where its domain is accounted as domain.
+ */
+MemoryFootprint variable_memory_footprint(const VisitVariableVariant &variable);
+
+/**
+ * Class that represents a cartesian product of sets, i.e. a box in the product algebra.
+ *
+ * Variables that are not assigned are not constrained and take their entire domain, such that a box only stores and
+ * visits the variables it constrains. A simple event without any assignments is the empty set.
+ */
 class SimpleEvent : public SimpleSetWrapper<Event, SimpleEvent, std::tuple<>> {
 public:
 
     SimpleEvent() = default;
 
-    explicit SimpleEvent(VariableAssignmentType &variableAssignmentType);
+    explicit SimpleEvent(const VariableAssignmentType &variableAssignmentType);
 
-    explicit SimpleEvent(std::map<VariableVariant , SetType> &assignment);
+    explicit SimpleEvent(const std::map<VariableVariant, SetType> &assignment);
 
     VariableAssignmentType variable_assignments;
 
-    SimpleEvent simple_set_intersection_with(const SimpleEvent &other) const;
+    [[nodiscard]] SimpleEvent simple_set_intersection_with(const SimpleEvent &other) const;
 
-    Event simple_set_complement() const;
+    /**
+     * Construct the complement dimension by dimension.
+     * The i-th box keeps the assignments of this for the variables before i, takes the complement of the i-th
+     * assignment and leaves the variables after i unassigned.
+     * The result consists of at most one box per variable and is disjoint by construction.
+     *
+     * @return The complement of this simple event as disjoint event.
+     */
+    [[nodiscard]] Event simple_set_complement() const;
 
     bool simple_set_contains(const std::tuple<> &element) const;
 
-    bool simple_set_is_empty();
+    [[nodiscard]] bool simple_set_is_empty() const;
+
+    /**
+     * @return The heap memory of the assignments, including the names and domains of the variables.
+     */
+    [[nodiscard]] MemoryFootprint simple_set_memory_footprint() const;
+
+    /**
+     * Form the difference with another simple event dimension by dimension.
+     * The i-th box keeps the intersection of both for the variables before i, takes the difference of the i-th
+     * assignments and keeps the assignments of this for the variables after i.
+     * The result consists of at most one box per variable and is disjoint by construction.
+     *
+     * @param other The other simple event.
+     * @return The difference as disjoint event.
+     */
+    [[nodiscard]] Event difference_with(const SimpleEvent &other) const;
+
+    /**
+     * Check if this simple event is a subset of another one. Only the variables that the other assigns are visited.
+     *
+     * @param other The other simple event.
+     * @return True if every point of this lies in the other.
+     */
+    [[nodiscard]] bool is_subset_of(const SimpleEvent &other) const;
 
     /**
      * Merge the keys of this variable assignment with another variable assignment.
@@ -38,13 +112,244 @@ public:
      */
     std::set<VisitVariableVariant> merge_keys_of_assignments(const VariableAssignmentType &other_assignments) const;
 
+    bool operator==(const SimpleEvent &other) const;
+
+    bool operator<(const SimpleEvent &other) const {
+        return variable_assignments < other.variable_assignments;
+    }
+
+    bool operator<=(const SimpleEvent &other) const {
+        return !(other < *this);
+    }
+
+    [[nodiscard]] std::string to_string() const;
+
+    /**
+     * Measure this in the space of the variables it assigns. Since unassigned variables are not part of the product,
+     * compare the measures of events over different variables with the overload that takes the variables.
+     *
+     * @return The product of the measures of all assignments, where the measure of a set is its number of elements,
+     * or 0 if this is empty.
+     */
+    [[nodiscard]] double measure() const;
+
+    /**
+     * Measure this in the space of some variables, where every unassigned variable contributes the measure of its
+     * entire domain, which is infinite for continuous and integer variables and the size of the domain for symbolic
+     * ones.
+     *
+     * @param variables The variables of the space, which have to contain the variables this assigns.
+     * @return The product of the measures of this in all variables, or 0 if this is empty.
+     */
+    [[nodiscard]] double measure(const std::set<VisitVariableVariant> &variables) const;
+
+};
+
+/**
+ * Bounds of all boxes of an event per variable.
+ * Boxes that do not assign a variable cover its entire domain, so only the variables that every box assigns are
+ * bounded. Variables whose bounds cover their entire domain are left out as well.
+ */
+struct EventHull {
+
+    /**
+     * True if the event has no boxes.
+     */
+    bool empty = true;
+
+    /**
+     * The smallest simple interval that contains the intervals of all boxes, per variable that is assigned intervals.
+     */
+    std::map<VisitVariableVariant, SimpleInterval> intervals;
+
+    /**
+     * The elements of the sets of all boxes as bits in the order of the domain, per symbolic variable.
+     */
+    std::map<VisitVariableVariant, std::vector<std::uint64_t>> symbols;
+
+    /**
+     * @return True if no point lies in both hulls.
+     */
+    [[nodiscard]] bool is_disjoint_with(const EventHull &other) const;
+
+    /**
+     * @return True if every point of the other hull lies in this hull.
+     */
+    [[nodiscard]] bool contains(const EventHull &other) const;
+};
+
+/**
+ * The bounding hull of an event is an EventHull.
+ */
+template<>
+struct BoundingHullType<SimpleEvent> {
+    using type = EventHull;
 };
 
 /**
  * Class that represents the product algebra.
  */
-class Event : public CompositeSetWrapper<Event, SimpleEvent, std::tuple<int>> {
+class Event : public CompositeSetWrapper<Event, SimpleEvent, std::tuple<>> {
+public:
+
+    Event() = default;
+
+    explicit Event(const SimpleSetType<SimpleEvent> &simple_events) : CompositeSetWrapper(simple_events) {}
 
+    explicit Event(const SimpleEvent &simple_event) {
+        if (!simple_event.is_empty()) {
+            this->simple_sets.insert(simple_event);
+        }
+    }
+
+    /**
+     * Simplify the event by merging boxes that have equal assignments for all but one variable.
+     * Boxes are grouped by a hash of their other dimensions and the sets of the remaining dimension are united.
+     * This is repeated until no more boxes can be merged.
+     *
+     * @return The simplified event.
+     */
     Event composite_set_simplify();
 
-};
\ No newline at end of file
+    /**
+     * Merge the boxes that have equal assignments for all variables except the given one.
+     *
+     * @param variable The variable along which boxes are merged.
+     * @return The merged event and true if any boxes were merged.
+     */
+    [[nodiscard]] std::tuple<Event, bool> merge_boxes_along(const VisitVariableVariant &variable) const;
+
+    /**
+     * Approximate this event by a superset with fewer simple intervals in its continuous dimensions.
+     * Every interval of every box is coarsened with the same parameters and boxes that overlap afterwards are made
+     * disjoint again.
+     *
+     * @param max_pieces The maximum number of simple intervals per dimension of a box.
+     * @param epsilon The length below which gaps are always closed.
+     * @return The coarsened event and the measure it added to this in the space of the variables of this, which is
+     * infinite if a closed gap lies in an unbounded box.
+     */
+    [[nodiscard]] std::tuple<Event, double> coarsen(std::size_t max_pieces, float epsilon = 0) const;
+
+    /**
+     * @return The variables that are assigned by any box.
+     */
+    [[nodiscard]] std::set<VisitVariableVariant> variables() const;
+
+    /**
+     * Measure this in the space of some variables. The boxes have to be disjoint for the sum of their measures to be
+     * the measure of this.
+     *
+     * @param variables The variables of the space, which have to contain the variables of all boxes.
+     * @return The sum of the measures of all boxes, where unassigned variables count with their entire domain.
+     */
+    [[nodiscard]] double measure(const std::set<VisitVariableVariant> &variables) const;
+
+    /**
+     * @return The measure of this in the space of its own variables.
+     */
+    [[nodiscard]] double measure() const {
+        return measure(variables());
+    }
+
+    /**
+     * Form the complement by removing one box after another from the complement of the first box.
+     * The complement of the empty event is empty, since it has no variables.
+     *
+     * @return The complement as disjoint event.
+     */
+    [[nodiscard]] Event complement() const;
+
+    /**
+     * Form the complement within a budget. The budget is checked after every removed box.
+     *
+     * @param budget The budget of the operation.
+     * @return The complement as disjoint event and the status. If the status is not OK, the event is empty.
+     */
+    [[nodiscard]] std::tuple<Event, OperationStatus> complement(const OperationBudget &budget) const;
+
+    /**
+     * The bounding hull is computed once and shared by all copies until the boxes are modified.
+     *
+     * @return The bounds of all boxes per variable.
+     */
+    [[nodiscard]] const EventHull &bounding_hull() const;
+
+    /**
+     * @return True if the bounding hulls of this and another event do not intersect.
+     */
+    [[nodiscard]] bool bounding_hulls_disjoint(const Event &other) const;
+
+    /**
+     * @return True if the bounding hull of this contains the one of another event.
+     */
+    [[nodiscard]] bool bounding_hull_contains(const Event &other) const;
+
+    using CompositeSetWrapper::difference_with;
+
+    /**
+     * Form the difference with a simple event box by box.
+     * The difference is disjoint if this is disjoint.
+     *
+     * @param other The simple event to remove.
+     * @return The difference.
+     */
+    [[nodiscard]] Event difference_with(const SimpleEvent &other) const;
+
+    /**
+     * Form the difference with another event by removing its boxes one after another.
+     * The difference is disjoint if this is disjoint.
+     *
+     * @param other The event to remove.
+     * @return The difference.
+     */
+    [[nodiscard]] Event difference_with(const Event &other) const;
+
+    /**
+     * Form the difference with another event within a budget. The budget is checked after every removed box.
+     *
+     * @param other The event to remove.
+     * @param budget The budget of the operation.
+     * @return The difference and the status. If the status is not OK, the event is empty.
+     */
+    [[nodiscard]] std::tuple<Event, OperationStatus> difference_with(const Event &other,
+                                                                     const OperationBudget &budget) const;
+
+    /**
+     * Project this event onto a subset of its variables, i.e. the set of all assignments of these variables that can
+     * be extended to an assignment in this event.
+     *
+     * The boxes are restricted to the variables and duplicates are dropped. The projected boxes are then swept
+     * dimension by dimension: the first dimension is cut into slabs at the borders of all boxes, the boxes covering a
+     * slab are projected recursively onto the remaining dimensions, and slabs with equal remainders are merged.
+     * For a single variable this takes O(n log n) time in the number of simple sets.
+     *
+     * @param variables The variables to keep. Variables that a box does not constrain take their entire domain.
+     * @return The projection as disjoint event.
+     */
+    [[nodiscard]] Event project(const std::set<VisitVariableVariant> &variables) const;
+
+};
+
+/**
+ * Form the union of many events at once by a balanced reduction.
+ *
+ * Neighbouring events are united pairwise, level after level, such that every event takes part in O(log k) unions
+ * of k events. Two disjoint events are united by adding the boxes of one without the other, and the result is
+ * simplified once at the end. The two halves of the reduction can be run on separate threads.
+ *
+ * @param events The events to unite.
+ * @param parallel Whether to unite the halves of the reduction in parallel, up to the hardware concurrency.
+ * @return The union as disjoint event.
+ */
+Event union_all(const std::vector<Event> &events, bool parallel = false);
+
+/**
+ * Form the intersection of many events at once by a balanced reduction of pairwise intersections of boxes.
+ * The result is simplified once at the end.
+ *
+ * @param events The events to intersect. There has to be at least one.
+ * @param parallel Whether to intersect the halves of the reduction in parallel, up to the hardware concurrency.
+ * @return The intersection as disjoint event.
+ */
+Event intersection_all(const std::vector<Event> &events, bool parallel = false);
@@ -0,0 +1,232 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include <variant>
+#include "interval.h"
+#include "set.h"
+#include "product_algebra.h"
+
+/**
+ * Fast pseudo random number generator (xoshiro256++).
+ *
+ * The generator satisfies the UniformRandomBitGenerator requirements. Independent streams for multiple threads are
+ * obtained by seeding one generator per thread or by calling `jump` on copies of the same generator.
+ */
+class Xoshiro256 {
+public:
+    using result_type = std::uint64_t;
+
+    /**
+     * Construct a generator from a seed. The state is expanded from the seed with splitmix64.
+     */
+    explicit Xoshiro256(std::uint64_t seed = 0);
+
+    /**
+     * Construct a generator for a thread. Different thread indices yield independent streams for the same seed.
+     */
+    static Xoshiro256 for_thread(std::uint64_t seed, std::size_t thread_index);
+
+    static constexpr result_type min() {
+        return 0;
+    }
+
+    static constexpr result_type max() {
+        return UINT64_MAX;
+    }
+
+    result_type operator()();
+
+    /**
+     * @return A uniformly distributed float in [0, 1).
+     */
+    float uniform_float();
+
+    /**
+     * @return A uniformly distributed double in [0, 1) with 53 random bits.
+     */
+    double uniform_double();
+
+    /**
+     * @return A uniformly distributed integer in [0, bound).
+     */
+    std::uint64_t uniform_below(std::uint64_t bound);
+
+    /**
+     * Advance the generator by 2^128 steps.
+     */
+    void jump();
+
+private:
+    std::uint64_t state[4]{};
+};
+
+/**
+ * Alias table (Vose's method) for sampling indices from a discrete distribution in O(1).
+ */
+class AliasTable {
+public:
+    AliasTable() = default;
+
+    /**
+     * Construct the alias table from non-negative weights.
+     * If all weights are zero, every index is equally likely.
+     */
+    explicit AliasTable(const std::vector<double> &weights);
+
+    /**
+     * @return An index that is distributed according to the weights.
+     */
+    std::size_t sample(Xoshiro256 &rng) const;
+
+    [[nodiscard]] std::size_t size() const {
+        return probabilities.size();
+    }
+
+private:
+    std::vector<float> probabilities;
+    std::vector<std::uint32_t> aliases;
+};
+
+/**
+ * Uniform sampler for intervals.
+ *
+ * The pieces are chosen proportional to their length. Integer samplers only produce whole numbers and choose the
+ * pieces proportional to the number of integers in them.
+ */
+class IntervalSampler {
+public:
+    IntervalSampler() = default;
+
+    /**
+     * Precompute the sampler of an interval.
+     * @param interval The disjoint interval to sample from. It has to be bounded.
+     * @param integer True if only whole numbers should be sampled.
+     */
+    explicit IntervalSampler(const Interval &interval, bool integer = false);
+
+    /**
+     * @return One sample.
+     */
+    float sample(Xoshiro256 &rng) const;
+
+    /**
+     * Write a batch of samples into a caller-provided buffer.
+     * @param count The number of samples.
+     * @param rng The random number generator.
+     * @param out The buffer, which has to hold at least count values.
+     */
+    void sample(std::size_t count, Xoshiro256 &rng, float *out) const;
+
+    /**
+     * @return The length of the interval or the number of integers in it.
+     */
+    [[nodiscard]] double measure() const {
+        return total_measure;
+    }
+
+private:
+    std::vector<SimpleInterval> pieces;
+    AliasTable alias_table;
+    double total_measure = 0;
+    bool integer = false;
+};
+
+/**
+ * Uniform sampler for sets.
+ *
+ * Samples are written as indices into the sorted elements of the domain of the set.
+ */
+class SetSampler {
+public:
+    SetSampler() = default;
+
+    /**
+     * Precompute the sampler of a set.
+     * @param set The non-empty set to sample from.
+     */
+    explicit SetSampler(const Set &set);
+
+    /**
+     * @return The index of one sampled element.
+     */
+    std::size_t sample(Xoshiro256 &rng) const;
+
+    /**
+     * Write a batch of samples into a caller-provided buffer.
+     * @param count The number of samples.
+     * @param rng The random number generator.
+     * @param out The buffer, which has to hold at least count values.
+     */
+    void sample(std::size_t count, Xoshiro256 &rng, std::size_t *out) const;
+
+    /**
+     * @return The number of elements in the set.
+     */
+    [[nodiscard]] double measure() const {
+        return static_cast<double>(element_indices.size());
+    }
+
+    /**
+     * @return The sorted elements of the domain the sample indices refer to.
+     */
+    [[nodiscard]] const std::vector<std::string> &elements() const {
+        return domain;
+    }
+
+private:
+    std::vector<std::string> domain;
+    std::vector<std::size_t> element_indices;
+    AliasTable alias_table;
+};
+
+/**
+ * A caller-provided column for the samples of one variable.
+ * Continuous and integer variables are written as floats, symbolic variables as indices into their sorted domain.
+ */
+using SampleColumn = std::variant<float *, std::size_t *>;
+
+/**
+ * Uniform sampler for events.
+ *
+ * The boxes are chosen proportional to their measure using an alias table and every dimension of the chosen box is
+ * sampled independently. The sampler precomputes everything, such that keeping it around makes repeated sampling
+ * from the same event O(1) per sample.
+ */
+class EventSampler {
+public:
+    /**
+     * Precompute the sampler of an event.
+     * @param event The disjoint event to sample from. Every continuous dimension has to be bounded.
+     * Boxes without any value, such as integer boxes between two integers, are never sampled, but at least one box
+     * has to contain a value.
+     */
+    explicit EventSampler(const Event &event);
+
+    /**
+     * @return The variables in the order of the columns.
+     */
+    [[nodiscard]] const std::vector<VisitVariableVariant> &variables() const {
+        return all_variables;
+    }
+
+    /**
+     * Write a batch of samples into caller-provided columns.
+     * @param count The number of samples.
+     * @param rng The random number generator.
+     * @param columns One column per variable in the order of `variables()`, each holding at least count values.
+     */
+    void sample(std::size_t count, Xoshiro256 &rng, const std::vector<SampleColumn> &columns) const;
+
+private:
+    using DimensionSampler = std::variant<IntervalSampler, SetSampler>;
+
+    std::vector<VisitVariableVariant> all_variables;
+
+    /**
+     * The samplers of every box that contains a value, one per variable.
+     */
+    std::vector<std::vector<DimensionSampler>> box_samplers;
+
+    AliasTable alias_table;
+};
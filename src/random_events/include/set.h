@@ -1,19 +1,131 @@
 #pragma once
 
 #include "sigma_algebra.h"
+#include <initializer_list>
+#include <memory>
 #include <set>
+#include <string>
 #include <utility>
 #include <algorithm>
 
 class Set; // Forward declaration
 
+/**
+ * Immutable set of elementary events that is shared by all copies, such that copying a set or one of its elements
+ * does not copy the domain. It offers the read-only interface of std::set.
+ */
+class SharedElements {
+public:
+    using container_type = std::set<std::string>;
+    using value_type = container_type::value_type;
+    using size_type = container_type::size_type;
+    using const_iterator = container_type::const_iterator;
+    using iterator = const_iterator;
+
+    /**
+     * Construct the empty domain, which is shared by all empty domains and does not allocate.
+     */
+    SharedElements() : elements(empty_elements()) {}
+
+    SharedElements(container_type elements) :
+            elements(std::make_shared<const container_type>(std::move(elements))) {}
+
+    SharedElements(std::initializer_list<std::string> elements) : SharedElements(container_type(elements)) {}
+
+    [[nodiscard]] const container_type &get() const {
+        return *elements;
+    }
+
+    operator const container_type &() const {
+        return *elements;
+    }
+
+    [[nodiscard]] const_iterator begin() const {
+        return elements->begin();
+    }
+
+    [[nodiscard]] const_iterator end() const {
+        return elements->end();
+    }
+
+    [[nodiscard]] size_type size() const {
+        return elements->size();
+    }
+
+    [[nodiscard]] bool empty() const {
+        return elements->empty();
+    }
+
+    [[nodiscard]] const_iterator find(const std::string &element) const {
+        return elements->find(element);
+    }
+
+    [[nodiscard]] size_type count(const std::string &element) const {
+        return elements->count(element);
+    }
+
+    [[nodiscard]] const_iterator lower_bound(const std::string &element) const {
+        return elements->lower_bound(element);
+    }
+
+    /**
+     * @return True if this shares its storage with other.
+     */
+    [[nodiscard]] bool shares_storage_with(const SharedElements &other) const {
+        return elements == other.elements;
+    }
+
+    /**
+     * @return The address of the storage, which identifies it among all copies.
+     */
+    [[nodiscard]] const void *storage_address() const {
+        return elements.get();
+    }
+
+    bool operator==(const SharedElements &other) const {
+        return elements == other.elements || *elements == *other.elements;
+    }
+
+    bool operator!=(const SharedElements &other) const {
+        return !(*this == other);
+    }
+
+    bool operator<(const SharedElements &other) const {
+        return *elements < *other.elements;
+    }
+
+    friend bool operator==(const SharedElements &first, const container_type &second) {
+        return first.get() == second;
+    }
+
+    friend bool operator==(const container_type &first, const SharedElements &second) {
+        return first == second.get();
+    }
+
+    friend bool operator!=(const SharedElements &first, const container_type &second) {
+        return !(first == second);
+    }
+
+    friend bool operator!=(const container_type &first, const SharedElements &second) {
+        return !(first == second);
+    }
+
+private:
+    static const std::shared_ptr<const container_type> &empty_elements() {
+        static const auto empty = std::make_shared<const container_type>();
+        return empty;
+    }
+
+    std::shared_ptr<const container_type> elements;
+};
+
 class SimpleSet : public SimpleSetWrapper<Set, SimpleSet, std::string> {
 public:
 
     /**
      * A set that contains all elements that are possible. In Kolmogorov's terms, this is the set of elementary events.
      */
-    const std::set<std::string> all_elements;
+    const SharedElements all_elements;
 
     /**
      * The element itself as string.
@@ -22,11 +134,10 @@ public:
 
     SimpleSet() = default;
 
-    explicit SimpleSet(std::string element, std::set<std::string> all_elements) : element(std::move(element)),
-                                                                                  all_elements(
-                                                                                          std::move(all_elements)) {}
+    explicit SimpleSet(std::string element, SharedElements all_elements) : all_elements(std::move(all_elements)),
+                                                                           element(std::move(element)) {}
 
-    explicit SimpleSet(std::set<std::string> all_elements) : all_elements(std::move(all_elements)) {}
+    explicit SimpleSet(SharedElements all_elements) : all_elements(std::move(all_elements)) {}
 
     [[nodiscard]] SimpleSet simple_set_intersection_with(const SimpleSet &other) const;
 
@@ -36,17 +147,23 @@ public:
 
     [[nodiscard]] bool simple_set_is_empty() const;
 
+    /**
+     * @return The heap memory of the element and of all elements, which are shared with the other elements of the
+     * domain.
+     */
+    [[nodiscard]] MemoryFootprint simple_set_memory_footprint() const;
+
     bool operator==(const SimpleSet &other) const;
 
     [[nodiscard]] std::string to_string() const;
 
     explicit operator std::string() const;
 
-    bool operator<(const SimpleSet &other) const override {
+    bool operator<(const SimpleSet &other) const {
         return element < other.element;
     }
 
-    bool operator<=(const SimpleSet &other) const override {
+    bool operator<=(const SimpleSet &other) const {
         return element <= other.element;
     }
 
@@ -72,25 +189,40 @@ namespace std {
 class Set : public CompositeSetWrapper<Set, SimpleSet, std::string> {
 public:
 
-    std::set<std::string> all_elements;
+    SharedElements all_elements;
 
     explicit Set() = default;
 
-    explicit Set(const SimpleSetType<SimpleSet> &simple_sets, const std::set<std::string> &all_elements) :
+    explicit Set(const SimpleSetType<SimpleSet> &simple_sets, const SharedElements &all_elements) :
             empty_simple_set(SimpleSet(all_elements)) {
         this->simple_sets = simple_sets;
         this->all_elements = all_elements;
         this->empty_simple_set_ptr = &empty_simple_set;
     }
 
-    explicit Set(std::set<std::string> all_elements) :
+    /**
+     * Construct a set from simple sets that share the same elementary events.
+     */
+    explicit Set(const SimpleSetType<SimpleSet> &simple_sets) {
+        this->simple_sets = simple_sets;
+        if (!simple_sets.empty()) {
+            this->all_elements = simple_sets.begin()->all_elements;
+        }
+    }
+
+    explicit Set(SharedElements all_elements) :
             empty_simple_set(SimpleSet(std::move(all_elements))) {
-        this->all_elements = all_elements;
+        this->all_elements = empty_simple_set.all_elements;
         this->empty_simple_set_ptr = &empty_simple_set;
     }
 
     Set composite_set_simplify();
 
+    /**
+     * @return The heap memory of the simple sets and of all elements referenced by this set.
+     */
+    [[nodiscard]] MemoryFootprint memory_footprint() const;
+
     SimpleSet empty_simple_set;
 
 
@@ -105,4 +237,32 @@ public:
     }
 
 
-};
\ No newline at end of file
+};
+
+/**
+ * Form the union of many sets at once by collecting their elements, which are disjoint by definition.
+ *
+ * @param sets The sets to unite. They have to share their domain.
+ * @return The union.
+ */
+Set union_all(const std::vector<Set> &sets);
+
+/**
+ * Form the intersection of many sets at once by keeping the elements of the smallest set that are in all other sets.
+ *
+ * @param sets The sets to intersect. They have to share their domain and there has to be at least one.
+ * @return The intersection.
+ */
+Set intersection_all(const std::vector<Set> &sets);
+
+/**
+ * Hash function for sets.
+ */
+namespace std {
+    template<>
+    struct hash<Set> {
+        size_t operator()(const Set &set) const {
+            return set.hash();
+        }
+    };
+}
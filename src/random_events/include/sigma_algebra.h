@@ -1,13 +1,576 @@
 #pragma once
 
 #include <set>
+#include <map>
+#include <array>
 #include <vector>
 #include <tuple>
 #include <memory>
+#include <string>
+#include <atomic>
+#include <chrono>
+#include <limits>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <iterator>
+#include <utility>
+#include <thread>
+#include <variant>
 
 template<typename T>
 using SimpleSetType = std::set<T>;
 
+/**
+ * The type of the bounding hull of the simple sets of a composite set, which is cached with the simple sets.
+ * Simple sets whose composite sets have no bounding hull use std::monostate.
+ */
+template<typename T_SimpleSet>
+struct BoundingHullType {
+    using type = std::monostate;
+};
+
+/**
+ * Ordered set of simple sets whose storage is shared between copies until one of them is modified.
+ *
+ * Copying is O(1) and only increments a reference count. The shared storage is never modified, such that any number of
+ * threads may read copies of the same set concurrently. A modifying member function first detaches the storage by
+ * copying it if it is shared with another set. Iterators are always const and are invalidated by modifications.
+ *
+ * The storage also holds the bounding hull of the simple sets, which is computed at most once for all copies and
+ * dropped when the simple sets are modified.
+ */
+template<typename T>
+class CopyOnWriteSet {
+public:
+    using container_type = SimpleSetType<T>;
+    using value_type = T;
+    using size_type = typename container_type::size_type;
+    using const_iterator = typename container_type::const_iterator;
+    using iterator = const_iterator;
+    using hull_type = typename BoundingHullType<T>::type;
+
+    /**
+     * Construct an empty set. All empty sets share the same storage, such that this does not allocate.
+     */
+    CopyOnWriteSet() : storage(empty_storage()) {}
+
+    CopyOnWriteSet(const container_type &container) : storage(std::make_shared<Storage>(container)) {}
+
+    CopyOnWriteSet(container_type &&container) : storage(std::make_shared<Storage>(std::move(container))) {}
+
+    CopyOnWriteSet(std::initializer_list<T> values) : storage(std::make_shared<Storage>(container_type(values))) {}
+
+    /**
+     * @return The underlying container.
+     */
+    [[nodiscard]] const container_type &get() const {
+        return storage->elements;
+    }
+
+    operator const container_type &() const {
+        return storage->elements;
+    }
+
+    [[nodiscard]] const_iterator begin() const {
+        return storage->elements.begin();
+    }
+
+    [[nodiscard]] const_iterator end() const {
+        return storage->elements.end();
+    }
+
+    [[nodiscard]] size_type size() const {
+        return storage->elements.size();
+    }
+
+    [[nodiscard]] bool empty() const {
+        return storage->elements.empty();
+    }
+
+    [[nodiscard]] const_iterator find(const T &value) const {
+        return storage->elements.find(value);
+    }
+
+    [[nodiscard]] size_type count(const T &value) const {
+        return storage->elements.count(value);
+    }
+
+    std::pair<const_iterator, bool> insert(const T &value) {
+        return mutable_storage().insert(value);
+    }
+
+    template<typename InputIterator>
+    void insert(InputIterator first, InputIterator last) {
+        if (first != last) {
+            mutable_storage().insert(first, last);
+        }
+    }
+
+    size_type erase(const T &value) {
+        return storage->elements.count(value) == 0 ? 0 : mutable_storage().erase(value);
+    }
+
+    void clear() {
+        storage = empty_storage();
+    }
+
+    /**
+     * Get the bounding hull of the simple sets, which is computed by the first caller and shared by all copies until
+     * the simple sets are modified. Concurrent callers wait for the first one.
+     *
+     * @param compute The function that computes the bounding hull of a container of simple sets.
+     * @return The bounding hull, which is valid until this is modified.
+     */
+    template<typename Compute>
+    const hull_type &bounding_hull(const Compute &compute) const {
+        auto state = storage->hull_state.load(std::memory_order_acquire);
+        while (state != HULL_READY) {
+            auto expected = HULL_EMPTY;
+            if (state == HULL_EMPTY && storage->hull_state.compare_exchange_strong(expected, HULL_COMPUTING,
+                                                                                   std::memory_order_acquire)) {
+                try {
+                    storage->hull = compute(storage->elements);
+                } catch (...) {
+                    storage->hull_state.store(HULL_EMPTY, std::memory_order_release);
+                    throw;
+                }
+                storage->hull_state.store(HULL_READY, std::memory_order_release);
+                break;
+            }
+            std::this_thread::yield();
+            state = storage->hull_state.load(std::memory_order_acquire);
+        }
+        return storage->hull;
+    }
+
+    /**
+     * @return True if this shares its storage with other.
+     */
+    [[nodiscard]] bool shares_storage_with(const CopyOnWriteSet &other) const {
+        return storage == other.storage;
+    }
+
+    /**
+     * @return The address of the storage, which identifies it among all sets that share it.
+     */
+    [[nodiscard]] const void *storage_address() const {
+        return storage.get();
+    }
+
+    bool operator==(const CopyOnWriteSet &other) const {
+        return storage == other.storage || storage->elements == other.storage->elements;
+    }
+
+    bool operator!=(const CopyOnWriteSet &other) const {
+        return !(*this == other);
+    }
+
+    bool operator==(const container_type &other) const {
+        return storage->elements == other;
+    }
+
+    bool operator!=(const container_type &other) const {
+        return storage->elements != other;
+    }
+
+    bool operator<(const CopyOnWriteSet &other) const {
+        return storage != other.storage && storage->elements < other.storage->elements;
+    }
+
+private:
+
+    static constexpr std::uint8_t HULL_EMPTY = 0;
+    static constexpr std::uint8_t HULL_COMPUTING = 1;
+    static constexpr std::uint8_t HULL_READY = 2;
+
+    /**
+     * The simple sets and their cached bounding hull.
+     */
+    struct Storage {
+        explicit Storage(const container_type &elements) : elements(elements) {}
+
+        explicit Storage(container_type &&elements) : elements(std::move(elements)) {}
+
+        container_type elements;
+        mutable std::atomic<std::uint8_t> hull_state{HULL_EMPTY};
+        mutable hull_type hull;
+    };
+
+    /**
+     * @return The storage of all empty sets.
+     */
+    static const std::shared_ptr<Storage> &empty_storage() {
+        static const auto empty = std::make_shared<Storage>(container_type());
+        return empty;
+    }
+
+    /**
+     * @return The storage for modification, which is copied first if it is shared.
+     */
+    container_type &mutable_storage() {
+        if (storage.use_count() != 1) {
+            storage = std::make_shared<Storage>(storage->elements);
+        } else {
+            // order the reads of copies that released the storage before the modification
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (storage->hull_state.load(std::memory_order_relaxed) != HULL_EMPTY) {
+                storage->hull = hull_type();
+                storage->hull_state.store(HULL_EMPTY, std::memory_order_relaxed);
+            }
+        }
+        return storage->elements;
+    }
+
+    std::shared_ptr<Storage> storage;
+};
+
+/**
+ * Enum for the outcome of operations that run under an operation budget.
+ */
+enum class OperationStatus {
+
+    /**
+     * The operation finished within its budget.
+     */
+    OK,
+
+    /**
+     * The operation produced more simple sets than allowed.
+     */
+    BUDGET_EXCEEDED,
+
+    /**
+     * The deadline passed before the operation finished.
+     */
+    DEADLINE_EXCEEDED,
+
+    /**
+     * The operation was cancelled through its cancellation token.
+     */
+    CANCELLED
+};
+
+/**
+ * Limits for operations that have to make composite sets disjoint and can therefore run for a long time.
+ * The default budget is unlimited.
+ */
+struct OperationBudget {
+
+    /**
+     * The point in time at which the operation has to give up.
+     */
+    std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::time_point::max();
+
+    /**
+     * A flag that is set by another thread to cancel the operation. It is ignored if it is a nullptr.
+     */
+    const std::atomic<bool> *cancellation_token = nullptr;
+
+    /**
+     * The maximum number of simple sets an intermediate result may contain.
+     */
+    std::size_t max_simple_sets = std::numeric_limits<std::size_t>::max();
+
+    /**
+     * @return A budget that expires after the given duration from now.
+     */
+    template<typename Rep, typename Period>
+    static OperationBudget with_timeout(std::chrono::duration<Rep, Period> timeout) {
+        OperationBudget budget;
+        budget.deadline = std::chrono::steady_clock::now() + timeout;
+        return budget;
+    }
+
+    /**
+     * Check if the budget is exhausted.
+     *
+     * @param number_of_simple_sets The number of simple sets the operation currently holds.
+     * @return The status of the operation.
+     */
+    [[nodiscard]] OperationStatus check(std::size_t number_of_simple_sets) const {
+        if (cancellation_token != nullptr && cancellation_token->load(std::memory_order_relaxed)) {
+            return OperationStatus::CANCELLED;
+        }
+        if (number_of_simple_sets > max_simple_sets) {
+            return OperationStatus::BUDGET_EXCEEDED;
+        }
+        if (deadline != std::chrono::steady_clock::time_point::max() &&
+            std::chrono::steady_clock::now() >= deadline) {
+            return OperationStatus::DEADLINE_EXCEEDED;
+        }
+        return OperationStatus::OK;
+    }
+};
+
+/**
+ * Enum for the operations of composite sets that can be traced.
+ */
+enum class TracedOperation : std::uint8_t {
+    INTERSECTION,
+    UNION,
+    DIFFERENCE,
+    COMPLEMENT,
+    MAKE_DISJOINT,
+    CONTAINS,
+    IS_DISJOINT,
+    SIMPLIFY
+};
+
+/**
+ * True while operations are recorded by the trace recorder, see trace.h.
+ */
+inline std::atomic<bool> operation_tracing_enabled{false};
+
+/**
+ * The number of traced operations the current thread is running, such that only the outermost one is recorded.
+ */
+inline thread_local int operation_trace_depth = 0;
+
+/**
+ * Record an operation with its operands and duration.
+ * It is defined by the trace recorder for the composite sets of this library.
+ */
+template<typename T_CompositeSet>
+void record_operation(TracedOperation operation, const T_CompositeSet &first, const T_CompositeSet *second,
+                      std::chrono::nanoseconds duration);
+
+/**
+ * Scope that measures an operation and records it when it ends if tracing is enabled.
+ * Operations that are started by other traced operations are not recorded.
+ */
+template<typename T_CompositeSet>
+class OperationTimer {
+public:
+    OperationTimer(TracedOperation operation, const T_CompositeSet &first, const T_CompositeSet *second = nullptr) :
+            operation(operation), first(first), second(second) {
+        recording = operation_trace_depth == 0 && operation_tracing_enabled.load(std::memory_order_relaxed);
+        if (recording) {
+            start = std::chrono::steady_clock::now();
+        }
+        ++operation_trace_depth;
+    }
+
+    OperationTimer(const OperationTimer &) = delete;
+
+    OperationTimer &operator=(const OperationTimer &) = delete;
+
+    ~OperationTimer() {
+        --operation_trace_depth;
+        if (recording) {
+            record_operation(operation, first, second, std::chrono::steady_clock::now() - start);
+        }
+    }
+
+private:
+    TracedOperation operation;
+    const T_CompositeSet &first;
+    const T_CompositeSet *second;
+    bool recording;
+    std::chrono::steady_clock::time_point start;
+};
+
+/**
+ * Heap memory held by a set, broken down by its origin.
+ * The sizes of container nodes are estimates based on the node layout of red-black trees.
+ * Storage that several sets share, such as copy-on-write simple sets and domains, is counted once, also when the
+ * footprints of several sets are added.
+ */
+struct MemoryFootprint {
+
+    /**
+     * The bytes of the nodes of sets and maps, including the values stored in them.
+     */
+    std::size_t container_nodes = 0;
+
+    /**
+     * The bytes of strings that do not fit into the small string buffer.
+     */
+    std::size_t strings = 0;
+
+    /**
+     * The bytes of domains, i.e. the elements of symbolic sets and the domains of variables.
+     */
+    std::size_t domains = 0;
+
+    /**
+     * The bytes of container nodes, strings and domains of every shared storage that is counted in this, by its
+     * address. The bytes of shared storage within shared storage are only listed for the inner storage.
+     */
+    std::map<const void *, std::array<std::size_t, 3>> shared_storage;
+
+    /**
+     * @return The total number of heap bytes.
+     */
+    [[nodiscard]] std::size_t total() const {
+        return container_nodes + strings + domains;
+    }
+
+    /**
+     * Add another footprint, where shared storage that both count is counted once.
+     */
+    MemoryFootprint &operator+=(const MemoryFootprint &other) {
+        container_nodes += other.container_nodes;
+        strings += other.strings;
+        domains += other.domains;
+        for (const auto &[storage, bytes]: other.shared_storage) {
+            if (!shared_storage.emplace(storage, bytes).second) {
+                container_nodes -= bytes[0];
+                strings -= bytes[1];
+                domains -= bytes[2];
+            }
+        }
+        return *this;
+    }
+
+    /**
+     * Declare this footprint of the contents of a storage as the footprint of the shared storage.
+     *
+     * @param storage The address of the storage.
+     * @return This.
+     */
+    MemoryFootprint &share(const void *storage) {
+        std::array<std::size_t, 3> bytes{container_nodes, strings, domains};
+        for (const auto &[inner_storage, inner_bytes]: shared_storage) {
+            for (std::size_t origin = 0; origin < bytes.size(); ++origin) {
+                bytes[origin] -= inner_bytes[origin];
+            }
+        }
+        shared_storage.emplace(storage, bytes);
+        return *this;
+    }
+
+    /**
+     * Count all bytes of this as bytes of domains.
+     *
+     * @return This.
+     */
+    MemoryFootprint &as_domain() {
+        domains = total();
+        container_nodes = 0;
+        strings = 0;
+        for (auto &[storage, bytes]: shared_storage) {
+            bytes = {0, 0, bytes[0] + bytes[1] + bytes[2]};
+        }
+        return *this;
+    }
+};
+
+/**
+ * @return The estimated size of a node of a std::set or std::map with the given value type.
+ */
+template<typename T>
+constexpr std::size_t tree_node_bytes() {
+    // color, parent, left and right followed by the value
+    constexpr std::size_t header = 4 * sizeof(void *);
+    constexpr std::size_t alignment = alignof(std::max_align_t);
+    return (header + sizeof(T) + alignment - 1) / alignment * alignment;
+}
+
+/**
+ * @return The heap bytes of a string or zero if it is stored in the small string buffer.
+ */
+inline std::size_t string_heap_bytes(const std::string &string) {
+    auto *data = reinterpret_cast<const char *>(string.data());
+    auto *object = reinterpret_cast<const char *>(&string);
+    if (data >= object && data < object + sizeof(std::string)) {
+        return 0;
+    }
+    return string.capacity() + 1;
+}
+
+/**
+ * @return The heap bytes of a set of strings.
+ */
+inline MemoryFootprint string_set_memory_footprint(const std::set<std::string> &strings) {
+    MemoryFootprint result;
+    for (const auto &string: strings) {
+        result.container_nodes += tree_node_bytes<std::string>();
+        result.strings += string_heap_bytes(string);
+    }
+    return result;
+}
+
+/**
+ * Lazy range over the unique pairs of elements of a container, i.e. all (A, B) where A comes before B.
+ * The pairs refer to the elements of the container, such that iterating them neither copies nor allocates.
+ */
+template<typename T_Container>
+class UniquePairs {
+public:
+    using element_iterator = typename T_Container::const_iterator;
+    using element_type = typename T_Container::value_type;
+    using value_type = std::pair<const element_type &, const element_type &>;
+
+    class iterator {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = UniquePairs::value_type;
+        using difference_type = std::ptrdiff_t;
+        using pointer = void;
+        using reference = value_type;
+
+        iterator(element_iterator first, element_iterator second, element_iterator end) : first(first),
+                                                                                           second(second),
+                                                                                           end(end) {}
+
+        value_type operator*() const {
+            return {*first, *second};
+        }
+
+        iterator &operator++() {
+            ++second;
+            if (second == end) {
+                ++first;
+                second = first == end ? end : std::next(first);
+                // the last element has no partner
+                if (second == end) {
+                    first = end;
+                }
+            }
+            return *this;
+        }
+
+        bool operator==(const iterator &other) const {
+            return first == other.first && second == other.second;
+        }
+
+        bool operator!=(const iterator &other) const {
+            return !(*this == other);
+        }
+
+    private:
+        element_iterator first;
+        element_iterator second;
+        element_iterator end;
+    };
+
+    explicit UniquePairs(const T_Container &container) : container(container) {}
+
+    [[nodiscard]] iterator begin() const {
+        auto first = container.begin();
+        if (first == container.end() || std::next(first) == container.end()) {
+            return end();
+        }
+        return iterator(first, std::next(first), container.end());
+    }
+
+    [[nodiscard]] iterator end() const {
+        return iterator(container.end(), container.end(), container.end());
+    }
+
+private:
+    const T_Container &container;
+};
+
+/**
+ * @return A lazy range over the unique pairs of elements of a container.
+ */
+template<typename T_Container>
+UniquePairs<T_Container> unique_pairs(const T_Container &container) {
+    return UniquePairs<T_Container>(container);
+}
+
 /**
 * Interface class for simple sets.
 */
@@ -74,6 +637,15 @@ public:
         return get_simple_set()->simple_set_is_empty();
     }
 
+    /**
+     * This method depends on the type of simple set and has to be overwritten.
+     *
+     * @return The heap memory held by this simple set, excluding the simple set itself.
+     */
+    [[nodiscard]] MemoryFootprint memory_footprint() const {
+        return get_simple_set()->simple_set_memory_footprint();
+    }
+
     /**
      * Form the difference with another simple set.
      *
@@ -111,26 +683,26 @@ public:
         return T_CompositeSet(difference);
     }
 
-    virtual bool operator<(const T_SimpleSet &other) const {
-        return get_simple_set()->operator<(other);
-    }
-
-    virtual bool operator<=(const T_SimpleSet &other) const {
-        return get_simple_set()->operator<=(other);
-    }
-
+    /**
+     * The derived simple set has to implement `operator<` and `operator<=`.
+     * They are resolved statically, such that simple sets carry no vtable and the comparisons can be inlined by
+     * `std::set` and `std::sort`.
+     */
     bool operator>(const T_SimpleSet &other) const {
-        return !operator<=(other);
+        return !(*get_simple_set() <= other);
     }
 
     bool operator>=(const T_SimpleSet &other) const {
-        return !operator<(other);
+        return !(*get_simple_set() < other);
     }
 
 
 };
 
 
+template<typename T_CompositeSet>
+class LazyComplement; // Forward declaration
+
 /**
 * Interface class for composite elements.
 * */
@@ -154,17 +726,15 @@ public:
     /**
      * Default Constructor.
      */
-    CompositeSetWrapper() {
-        simple_sets = SimpleSetType<T_SimpleSet>();
-    };
+    CompositeSetWrapper() = default;
 
     /**
      * Construct a composite set from a unordered set of simple sets.
      */
     explicit CompositeSetWrapper(const SimpleSetType<T_SimpleSet> &simple_sets_) {
-        for (auto simple_set: simple_sets) {
+        for (const auto &simple_set: simple_sets_) {
             if (!simple_set.is_empty()) {
-                simple_sets.push_back(simple_set);
+                simple_sets.insert(simple_set);
             }
         }
     }
@@ -182,7 +752,8 @@ public:
      * @return True if the composite set is disjoint union of simple sets.
      */
     [[nodiscard]] bool is_disjoint() const {
-        for (const auto &[first, second]: unique_combinations(simple_sets_as_vector())) {
+        OperationTimer<T_CompositeSet> timer(TracedOperation::IS_DISJOINT, *get_composite_set());
+        for (const auto &[first, second]: unique_pairs(simple_sets)) {
             if (!first.intersection_with(second).is_empty()) {
                 return false;
             }
@@ -190,6 +761,28 @@ public:
         return true;
     }
 
+    /**
+     * Find the pairs of simple sets that intersect.
+     *
+     * Composite sets can provide a faster method with the same name, which is then used by
+     * `split_into_disjoint_and_non_disjoint`.
+     *
+     * @return For every simple set in iteration order the positions of the other simple sets that it intersects.
+     */
+    [[nodiscard]] std::vector<std::vector<std::size_t>> overlapping_simple_sets() const {
+        auto simple_sets_view = simple_sets_as_view();
+        std::vector<std::vector<std::size_t>> result(simple_sets_view.size());
+        for (std::size_t i = 0; i < simple_sets_view.size(); ++i) {
+            for (std::size_t j = i + 1; j < simple_sets_view.size(); ++j) {
+                if (!simple_sets_view[i]->intersection_with(*simple_sets_view[j]).is_empty()) {
+                    result[i].push_back(j);
+                    result[j].push_back(i);
+                }
+            }
+        }
+        return result;
+    }
+
     /**
      * Simplify the composite set into a shorter but equal representation.
      * The size (shortness9 refers to the number of simple sets contained.
@@ -199,6 +792,7 @@ public:
      * @return The simplified composite set into a shorter but equal representation.
      */
     T_CompositeSet simplify() {
+        OperationTimer<T_CompositeSet> timer(TracedOperation::SIMPLIFY, *get_composite_set());
         return get_composite_set()->composite_set_simplify();
     }
 
@@ -206,6 +800,37 @@ public:
         return simple_sets == other.simple_sets;
     }
 
+    /**
+     * Order composite sets lexicographically by their simple sets.
+     * This is required to use composite sets as values of product algebra assignments.
+     */
+    bool operator<(const T_CompositeSet &other) const {
+        return simple_sets < other.simple_sets;
+    }
+
+    /**
+     * @return The heap memory held by the simple sets of this composite set, which copies share.
+     */
+    [[nodiscard]] MemoryFootprint memory_footprint() const {
+        MemoryFootprint result;
+        for (const auto &simple_set: simple_sets) {
+            result.container_nodes += tree_node_bytes<T_SimpleSet>();
+            result += simple_set.memory_footprint();
+        }
+        return result.share(simple_sets.storage_address());
+    }
+
+    /**
+     * @return A hash value that combines the hashes of all simple sets.
+     */
+    [[nodiscard]] std::size_t hash() const {
+        std::size_t result = 0;
+        for (const auto &simple_set: simple_sets) {
+            result ^= std::hash<T_SimpleSet>()(simple_set) + 0x9e3779b9 + (result << 6) + (result >> 2);
+        }
+        return result;
+    }
+
     /**
      * @return the simple sets as vector.
      */
@@ -213,6 +838,19 @@ public:
         return std::vector<T_SimpleSet>(simple_sets.begin(), simple_sets.end());
     }
 
+    /**
+     * @return Pointers to the simple sets in iteration order for access by position without copying them.
+     * The pointers are invalidated by modifications of this.
+     */
+    std::vector<const T_SimpleSet *> simple_sets_as_view() const {
+        std::vector<const T_SimpleSet *> result;
+        result.reserve(simple_sets.size());
+        for (const auto &simple_set: simple_sets) {
+            result.push_back(&simple_set);
+        }
+        return result;
+    }
+
     /**
      * @return A string representation of this.
      */
@@ -221,14 +859,11 @@ public:
             return "∅";
         }
         std::string result;
-
-        auto simple_sets_vector = simple_sets_as_vector();
-
-        for (size_t i = 0; i < simple_sets_vector.size(); ++i) {
-            result.append(simple_sets_vector[i].to_string());
-            if (i != simple_sets_vector.size() - 1) {
+        for (auto simple_set = simple_sets.begin(); simple_set != simple_sets.end(); ++simple_set) {
+            if (simple_set != simple_sets.begin()) {
                 result.append(" u ");
             }
+            result.append(simple_set->to_string());
         }
         return result;
     }
@@ -243,58 +878,80 @@ public:
      *
      * This method requires:
      *  - the intersection of two simple sets as a simple set
-     *  - the difference of a simple set (A) and another simple set (B) that is completely contained in A (B ⊆ A).
-     *      The result of that difference has to be a composite set with only one simple set in it.
+     *  - the difference of a simple set (A) and another simple set (B) as a disjoint composite set.
      *
      * @return A tuple of disjoint and non-disjoint composite sets.
      */
     std::tuple<T_CompositeSet, T_CompositeSet> split_into_disjoint_and_non_disjoint() const {
+        auto [disjoint, non_disjoint, status] = split_into_disjoint_and_non_disjoint(OperationBudget());
+        return std::make_tuple(disjoint, non_disjoint);
+    }
+
+    /**
+     * Split this composite set into disjoint and non-disjoint parts within a budget.
+     * The budget is checked for every simple set and after every non-empty pairwise intersection.
+     *
+     * @param budget The budget of the operation.
+     * @return A tuple of disjoint and non-disjoint composite sets and the status. If the status is not OK, both
+     * composite sets are empty.
+     */
+    std::tuple<T_CompositeSet, T_CompositeSet, OperationStatus>
+    split_into_disjoint_and_non_disjoint(const OperationBudget &budget) const {
 
         // initialize result for disjoint and non-disjoint sets
         T_CompositeSet disjoint;
         T_CompositeSet non_disjoint;
 
+        // only the pairs of simple sets that intersect have to be visited
+        auto simple_sets_view = simple_sets_as_view();
+        auto overlapping = get_composite_set()->overlapping_simple_sets();
+
         // for every pair of simple sets
-        for (const auto &simple_set_i: simple_sets) {
+        for (std::size_t i = 0; i < simple_sets_view.size(); ++i) {
+            const auto &simple_set_i = *simple_sets_view[i];
+
+            auto status = budget.check(disjoint.simple_sets.size() + non_disjoint.simple_sets.size());
+            if (status != OperationStatus::OK) {
+                return std::make_tuple(T_CompositeSet(), T_CompositeSet(), status);
+            }
 
             // initialize the difference of A_i
-            T_SimpleSet difference = simple_set_i;
+            T_CompositeSet difference;
+            difference.simple_sets.insert(simple_set_i);
 
-            // for every other simple set
-            for (const auto &simple_set_j: simple_sets) {
-
-                // if the atomic simple_sets are the same, skip
-                if (simple_set_i == simple_set_j) {
-                    continue;
-                }
+            // for every other simple set that intersects A_i
+            for (auto j: overlapping[i]) {
 
                 // get the intersection of the atomic simple_sets
-                auto intersection = simple_set_i.intersection_with(simple_set_j);
+                auto intersection = simple_set_i.intersection_with(*simple_sets_view[j]);
 
-                // if the intersection is not empty, append it to the non-disjoint set
-                if (!intersection.is_empty()) {
-                    non_disjoint.simple_sets.insert(intersection);
+                // if the intersection is empty, there is nothing to remove
+                if (intersection.is_empty()) {
+                    continue;
                 }
 
-                // get the difference of the simple set with the intersection.
-                auto difference_with_intersection = difference.difference_with(intersection);
-
-                // if the difference is empty
-                if (difference_with_intersection.is_empty()) {
+                // append the intersection to the non-disjoint set
+                non_disjoint.simple_sets.insert(intersection);
 
-                    // set the difference to simple empty and skip the rest
-                    difference = *empty_simple_set_ptr;
-                    continue;
+                status = budget.check(disjoint.simple_sets.size() + non_disjoint.simple_sets.size());
+                if (status != OperationStatus::OK) {
+                    return std::make_tuple(T_CompositeSet(), T_CompositeSet(), status);
                 }
 
-                // The difference should only contain 1 simple set since the intersection is completely in simple_set_i.
-                difference = *difference.difference_with(intersection).simple_sets.begin();
+                // remove the intersection from every remaining piece of A_i
+                T_CompositeSet difference_with_intersection;
+                for (const auto &piece: difference.simple_sets) {
+                    auto piece_difference = piece.difference_with(intersection);
+                    difference_with_intersection.simple_sets.insert(piece_difference.simple_sets.begin(),
+                                                                    piece_difference.simple_sets.end());
+                }
+                difference = difference_with_intersection;
             }
 
             // append the simple_set_i without every other simple set to the disjoint set
-            disjoint.simple_sets.insert(difference);
+            disjoint.simple_sets.insert(difference.simple_sets.begin(), difference.simple_sets.end());
         }
-        return std::make_tuple(disjoint, non_disjoint);
+        return std::make_tuple(disjoint, non_disjoint, OperationStatus::OK);
     }
 
     /**
@@ -303,27 +960,49 @@ public:
      * @return The disjoint composite set.
      */
     T_CompositeSet make_disjoint() const {
+        return std::get<0>(make_disjoint(OperationBudget()));
+    }
+
+    /**
+     * Create an equal composite set that contains a disjoint union of simple sets within a budget.
+     * The budget is checked between and within the rounds of splitting into disjoint and non-disjoint sets.
+     *
+     * @param budget The budget of the operation.
+     * @return The disjoint composite set and the status. If the status is not OK, the composite set is empty.
+     */
+    std::tuple<T_CompositeSet, OperationStatus> make_disjoint(const OperationBudget &budget) const {
+        OperationTimer<T_CompositeSet> timer(TracedOperation::MAKE_DISJOINT, *get_composite_set());
 
         // initialize disjoint, non-disjoint and current sets
         T_CompositeSet disjoint;
         T_CompositeSet intersections;
         T_CompositeSet current_disjoint;
+        OperationStatus status;
 
         // start with the initial split
-        std::tie(disjoint, intersections) = split_into_disjoint_and_non_disjoint();
+        std::tie(disjoint, intersections, status) = split_into_disjoint_and_non_disjoint(budget);
 
         // as long the splitting still produces non-disjoint sets
-        while (!intersections.is_empty()) {
+        while (status == OperationStatus::OK && !intersections.is_empty()) {
 
             // split into disjoint and non-disjoint sets
-            std::tie(current_disjoint, intersections) = intersections.split_into_disjoint_and_non_disjoint();
+            std::tie(current_disjoint, intersections, status) =
+                    intersections.split_into_disjoint_and_non_disjoint(budget);
 
             // extend the result by the disjoint sets
             disjoint.simple_sets.insert(current_disjoint.simple_sets.begin(), current_disjoint.simple_sets.end());
+
+            if (status == OperationStatus::OK) {
+                status = budget.check(disjoint.simple_sets.size() + intersections.simple_sets.size());
+            }
+        }
+
+        if (status != OperationStatus::OK) {
+            return std::make_tuple(T_CompositeSet(), status);
         }
 
         // simplify and return the disjoint set
-        return disjoint.simplify();
+        return std::make_tuple(disjoint.simplify(), OperationStatus::OK);
     }
 
 
@@ -353,7 +1032,11 @@ public:
      * @return The intersection as composite set.
      */
     T_CompositeSet intersection_with(const T_CompositeSet &other) const {
+        OperationTimer<T_CompositeSet> timer(TracedOperation::INTERSECTION, *get_composite_set(), &other);
         T_CompositeSet result;
+        if (get_composite_set()->bounding_hulls_disjoint(other)) {
+            return result;
+        }
         for (const auto &current_simple_set: simple_sets) {
             auto current_result = other.intersection_with(current_simple_set);
             result.simple_sets.insert(current_result.simple_sets.begin(), current_result.simple_sets.end());
@@ -365,6 +1048,18 @@ public:
      * @return the complement of a composite set as disjoint composite set.
      */
     T_CompositeSet complement() const {
+        return std::get<0>(complement(OperationBudget()));
+    }
+
+    /**
+     * Form the complement within a budget.
+     *
+     * @param budget The budget of the operation.
+     * @return The complement as disjoint composite set and the status. If the status is not OK, the composite set is
+     * empty.
+     */
+    std::tuple<T_CompositeSet, OperationStatus> complement(const OperationBudget &budget) const {
+        OperationTimer<T_CompositeSet> timer(TracedOperation::COMPLEMENT, *get_composite_set());
         T_CompositeSet result;
         bool first_iteration = true;
         for (const auto &simple_set: simple_sets) {
@@ -375,8 +1070,13 @@ public:
                 continue;
             }
             result = result.intersection_with(simple_set_complement);
+
+            auto status = budget.check(result.simple_sets.size());
+            if (status != OperationStatus::OK) {
+                return std::make_tuple(T_CompositeSet(), status);
+            }
         }
-        return result.make_disjoint();
+        return result.make_disjoint(budget);
     }
 
     /**
@@ -386,7 +1086,7 @@ public:
     * @return The union as disjoint composite set.
     */
     T_CompositeSet union_with(const T_SimpleSet &other) const {
-        T_CompositeSet result = T_CompositeSet(simple_sets);
+        T_CompositeSet result = *get_composite_set();
         result.simple_sets.insert(other);
         return result.make_disjoint();
     }
@@ -398,9 +1098,22 @@ public:
      * @return The union as disjoint composite set.
      */
     T_CompositeSet union_with(const T_CompositeSet &other) const {
-        T_CompositeSet result = T_CompositeSet(simple_sets);
+        return std::get<0>(union_with(other, OperationBudget()));
+    }
+
+    /**
+     * Form the union with another composite set within a budget.
+     *
+     * @param other The other composite set.
+     * @param budget The budget of the operation.
+     * @return The union as disjoint composite set and the status. If the status is not OK, the composite set is empty.
+     */
+    std::tuple<T_CompositeSet, OperationStatus> union_with(const T_CompositeSet &other,
+                                                           const OperationBudget &budget) const {
+        OperationTimer<T_CompositeSet> timer(TracedOperation::UNION, *get_composite_set(), &other);
+        T_CompositeSet result = *get_composite_set();
         result.simple_sets.insert(other.simple_sets.begin(), other.simple_sets.end());
-        return result.make_disjoint();
+        return result.make_disjoint(budget);
     }
 
 //    std::unique_ptr<AbstractCompositeSet> union_with(const AbstractCompositeSet &other) const override
@@ -432,6 +1145,26 @@ public:
      * @return The difference as disjoint composite set.
      */
     T_CompositeSet difference_with(const T_CompositeSet &other) const {
+        return std::get<0>(difference_with(other, OperationBudget()));
+    }
+
+    /**
+     * Form the difference with another composite set within a budget.
+     *
+     * @param other The other composite set.
+     * @param budget The budget of the operation.
+     * @return The difference as disjoint composite set and the status. If the status is not OK, the composite set is
+     * empty.
+     */
+    std::tuple<T_CompositeSet, OperationStatus> difference_with(const T_CompositeSet &other,
+                                                                const OperationBudget &budget) const {
+        OperationTimer<T_CompositeSet> timer(TracedOperation::DIFFERENCE, *get_composite_set(), &other);
+
+        // nothing is removed by the empty set or by a set outside of the bounding hull of this
+        if (other.is_empty() || get_composite_set()->bounding_hulls_disjoint(other)) {
+            return get_composite_set()->make_disjoint(budget);
+        }
+
         T_CompositeSet result;
 
         for (const auto &own_simple_set: simple_sets) {
@@ -448,8 +1181,13 @@ public:
                 current_difference = current_difference.intersection_with(difference);
             }
             result.simple_sets.insert(current_difference.simple_sets.begin(), current_difference.simple_sets.end());
+
+            auto status = budget.check(result.simple_sets.size());
+            if (status != OperationStatus::OK) {
+                return std::make_tuple(T_CompositeSet(), status);
+            }
         }
-        return result.make_disjoint();
+        return result.make_disjoint(budget);
     }
 
 //    std::unique_ptr<AbstractCompositeSet> difference_with(const AbstractCompositeSet &other) const override {
@@ -473,11 +1211,177 @@ public:
     }
 
     bool contains(const T_CompositeSet &other) const {
+        OperationTimer<T_CompositeSet> timer(TracedOperation::CONTAINS, *get_composite_set(), &other);
+        if (!other.is_empty() && !get_composite_set()->bounding_hull_contains(other)) {
+            return false;
+        }
         return intersection_with(other) == other;
     }
 
+    /**
+     * Check if the bounding hulls of this and another composite set are disjoint, which implies that both sets are.
+     * This has to be overwritten by composite sets with bounding hulls; the default never reports disjoint hulls.
+     *
+     * @param other The other composite set.
+     * @return True if the bounding hulls are disjoint.
+     */
+    [[nodiscard]] bool bounding_hulls_disjoint([[maybe_unused]] const T_CompositeSet &other) const {
+        return false;
+    }
+
+    /**
+     * Check if the bounding hull of this contains the one of another composite set, which is necessary for this to
+     * contain the other set.
+     * This has to be overwritten by composite sets with bounding hulls; the default always reports containment.
+     * Only `contains` uses it as early out. The other operations only use disjoint hulls, since a contained hull
+     * does not decide their result.
+     *
+     * @param other The other composite set.
+     * @return True if the bounding hull of this contains the one of other.
+     */
+    [[nodiscard]] bool bounding_hull_contains([[maybe_unused]] const T_CompositeSet &other) const {
+        return true;
+    }
+
+    /**
+     * Form the complement without computing its simple sets.
+     * This takes O(1) time, since the complement shares the simple sets of this.
+     *
+     * @return The complement of this.
+     */
+    LazyComplement<T_CompositeSet> lazy_complement() const {
+        return LazyComplement<T_CompositeSet>(*get_composite_set());
+    }
+
+    /**
+     * Form the intersection with a complement, which is the difference with the set it complements.
+     *
+     * @param other The complement.
+     * @return The intersection as disjoint composite set.
+     */
+    T_CompositeSet intersection_with(const LazyComplement<T_CompositeSet> &other) const {
+        return get_composite_set()->difference_with(other.complemented_set());
+    }
+
+    /**
+     * Form the difference with a complement, which is the intersection with the set it complements.
+     * The difference is only disjoint if this and the complemented set are disjoint.
+     *
+     * @param other The complement.
+     * @return The difference.
+     */
+    T_CompositeSet difference_with(const LazyComplement<T_CompositeSet> &other) const {
+        return get_composite_set()->intersection_with(other.complemented_set());
+    }
+
 public:
-    SimpleSetType<T_SimpleSet> simple_sets;
+    CopyOnWriteSet<T_SimpleSet> simple_sets;
+};
+
+/**
+ * The complement of a composite set whose simple sets are only formed when they are needed.
+ *
+ * Forming the complement intersects the complements of all simple sets and makes the result disjoint, which is
+ * expensive. Instead, this keeps the complemented set and rewrites membership tests and further operations with
+ * De Morgan's laws, such that they work on the complemented set:
+ *  - x in not A iff x not in A
+ *  - not A and B = B without A
+ *  - not A without B = not (A or B)
+ *  - not A or B = not (A without B)
+ *  - not not A = A
+ * The complement itself is only formed by `materialize`.
+ */
+template<typename T_CompositeSet>
+class LazyComplement {
+public:
+
+    /**
+     * @param complemented_set The set to complement.
+     */
+    explicit LazyComplement(T_CompositeSet complemented_set) : complemented(std::move(complemented_set)) {}
+
+    /**
+     * @return The set that this is the complement of.
+     */
+    [[nodiscard]] const T_CompositeSet &complemented_set() const {
+        return complemented;
+    }
+
+    /**
+     * @return The complement of this, which is the complemented set.
+     */
+    [[nodiscard]] const T_CompositeSet &complement() const {
+        return complemented;
+    }
+
+    /**
+     * @return True if the element is not in the complemented set.
+     */
+    template<typename T_Elementary>
+    [[nodiscard]] bool contains(const T_Elementary &element) const {
+        return !complemented.contains(element);
+    }
+
+    /**
+     * @return True if the other set does not intersect the complemented set.
+     */
+    [[nodiscard]] bool contains(const T_CompositeSet &other) const {
+        return complemented.intersection_with(other).is_empty();
+    }
+
+    /**
+     * @return The intersection with another set as disjoint composite set.
+     */
+    [[nodiscard]] T_CompositeSet intersection_with(const T_CompositeSet &other) const {
+        return other.difference_with(complemented);
+    }
+
+    /**
+     * @return The intersection with another complement, which is the complement of the union.
+     */
+    [[nodiscard]] LazyComplement intersection_with(const LazyComplement &other) const {
+        return LazyComplement(complemented.union_with(other.complemented));
+    }
+
+    /**
+     * @return The union with another set, which is the complement of the difference of the complemented set and it.
+     */
+    [[nodiscard]] LazyComplement union_with(const T_CompositeSet &other) const {
+        return LazyComplement(complemented.difference_with(other));
+    }
+
+    /**
+     * @return The union with another complement, which is the complement of the intersection.
+     */
+    [[nodiscard]] LazyComplement union_with(const LazyComplement &other) const {
+        return LazyComplement(complemented.intersection_with(other.complemented));
+    }
+
+    /**
+     * @return The difference with another set, which is the complement of the union.
+     */
+    [[nodiscard]] LazyComplement difference_with(const T_CompositeSet &other) const {
+        return LazyComplement(complemented.union_with(other));
+    }
+
+    /**
+     * @return The difference with another complement as disjoint composite set.
+     */
+    [[nodiscard]] T_CompositeSet difference_with(const LazyComplement &other) const {
+        return other.complemented.difference_with(complemented);
+    }
+
+    /**
+     * Form the simple sets of the complement.
+     *
+     * @return The complement as disjoint composite set.
+     */
+    [[nodiscard]] T_CompositeSet materialize() const {
+        return complemented.complement();
+    }
+
+private:
+    T_CompositeSet complemented;
 };
 
 
@@ -0,0 +1,428 @@
+#pragma once
+
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+#include "algebra_common.h"
+#include "product_algebra.h"
+
+/**
+ * The set type that variables of a type are assigned.
+ */
+template<typename T_Variable>
+struct DimensionType;
+
+template<>
+struct DimensionType<Continuous> {
+    using type = Interval;
+};
+
+template<>
+struct DimensionType<Integer> {
+    using type = Interval;
+};
+
+template<>
+struct DimensionType<Symbolic> {
+    using type = Set;
+};
+
+/**
+ * @return The real line, which is the domain of every interval.
+ */
+inline Interval entire_domain_of(const Interval &) {
+    return reals();
+}
+
+/**
+ * @return The set of all elementary events of a set.
+ */
+inline Set entire_domain_of(const Set &set) {
+
+    // the assignment of sets keeps the elementary events of the assigned set, which may be unknown while its elements
+    // know them
+    const auto &all_elements = set.all_elements.empty() && !set.simple_sets.empty() ?
+                               set.simple_sets.begin()->all_elements : set.all_elements;
+    return complement_within_domain(Set(SimpleSetType<SimpleSet>(), all_elements));
+}
+
+/**
+ * Box over a list of variable types that is fixed at compile time, with one interval or set per dimension.
+ *
+ * Unlike `SimpleEvent`, the dimensions are stored in a tuple instead of a map of variants, such that no dimension is
+ * looked up by its variable or dispatched by its type, and the operations are unrolled over the dimensions.
+ * Every dimension is assigned, where the sets of symbolic dimensions have to know their elementary events.
+ */
+template<typename... T_Variables>
+class StaticSimpleEvent {
+public:
+
+    using Assignments = std::tuple<typename DimensionType<T_Variables>::type...>;
+
+    static constexpr std::size_t dimensions = sizeof...(T_Variables);
+
+    /**
+     * The assignment of every dimension.
+     */
+    Assignments assignments;
+
+    StaticSimpleEvent() = default;
+
+    explicit StaticSimpleEvent(Assignments assignments) : assignments(std::move(assignments)) {}
+
+    /**
+     * @return True if any dimension is empty.
+     */
+    [[nodiscard]] bool is_empty() const {
+        return is_empty(Indices());
+    }
+
+    /**
+     * Intersect dimension by dimension, stopping at the first empty dimension.
+     *
+     * @return The intersection, which is empty if any dimension is.
+     */
+    [[nodiscard]] StaticSimpleEvent intersection_with(const StaticSimpleEvent &other) const {
+        StaticSimpleEvent result;
+        intersect(other, result, Indices());
+        return result;
+    }
+
+    /**
+     * Form the difference dimension by dimension like `SimpleEvent::difference_with`.
+     *
+     * @return The difference as disjoint boxes, at most one per dimension.
+     */
+    [[nodiscard]] std::vector<StaticSimpleEvent> difference_with(const StaticSimpleEvent &other) const {
+        auto intersection = intersection_with(other);
+        if (intersection.is_empty()) {
+            return {*this};
+        }
+        std::vector<StaticSimpleEvent> result;
+        auto current = *this;
+        difference(intersection, current, result, Indices());
+        return result;
+    }
+
+    /**
+     * @return The complement as disjoint boxes, at most one per dimension.
+     */
+    [[nodiscard]] std::vector<StaticSimpleEvent> complement() const {
+        return full_box().difference_with(*this);
+    }
+
+    /**
+     * @return The box of the entire domains of the dimensions of this.
+     */
+    [[nodiscard]] StaticSimpleEvent full_box() const {
+        return full_box(Indices());
+    }
+
+    /**
+     * @return True if every point of this lies in the other.
+     */
+    [[nodiscard]] bool is_subset_of(const StaticSimpleEvent &other) const {
+        return is_empty() || is_subset_of(other, Indices());
+    }
+
+    bool operator==(const StaticSimpleEvent &other) const {
+        return assignments == other.assignments;
+    }
+
+    bool operator!=(const StaticSimpleEvent &other) const {
+        return !(*this == other);
+    }
+
+private:
+
+    using Indices = std::index_sequence_for<T_Variables...>;
+
+    template<std::size_t... I>
+    bool is_empty(std::index_sequence<I...>) const {
+        return (std::get<I>(assignments).is_empty() || ...);
+    }
+
+    template<std::size_t... I>
+    void intersect(const StaticSimpleEvent &other, StaticSimpleEvent &result, std::index_sequence<I...>) const {
+        ((std::get<I>(result.assignments) = std::get<I>(assignments).intersection_with(std::get<I>(other.assignments)),
+          !std::get<I>(result.assignments).is_empty()) && ...);
+    }
+
+    template<std::size_t... I>
+    void difference(const StaticSimpleEvent &intersection, StaticSimpleEvent &current,
+                    std::vector<StaticSimpleEvent> &result, std::index_sequence<I...>) const {
+        (difference_of_dimension<I>(intersection, current, result), ...);
+    }
+
+    /**
+     * Add the box that differs from the intersection in dimension I, where current holds the intersection in the
+     * dimensions before I and this in the others.
+     */
+    template<std::size_t I>
+    void difference_of_dimension(const StaticSimpleEvent &intersection, StaticSimpleEvent &current,
+                                 std::vector<StaticSimpleEvent> &result) const {
+        auto difference = std::get<I>(assignments).difference_with(std::get<I>(intersection.assignments));
+        if (!difference.is_empty()) {
+            auto box = current;
+            std::get<I>(box.assignments) = std::move(difference);
+            result.push_back(std::move(box));
+        }
+        std::get<I>(current.assignments) = std::get<I>(intersection.assignments);
+    }
+
+    template<std::size_t... I>
+    StaticSimpleEvent full_box(std::index_sequence<I...>) const {
+        return StaticSimpleEvent(Assignments(entire_domain_of(std::get<I>(assignments))...));
+    }
+
+    template<std::size_t... I>
+    bool is_subset_of(const StaticSimpleEvent &other, std::index_sequence<I...>) const {
+        return (std::get<I>(assignments).difference_with(std::get<I>(other.assignments)).is_empty() && ...);
+    }
+};
+
+/**
+ * Disjoint union of boxes over a list of variable types that is fixed at compile time.
+ */
+template<typename... T_Variables>
+class StaticEvent {
+public:
+
+    using Box = StaticSimpleEvent<T_Variables...>;
+
+    /**
+     * The disjoint, non-empty boxes.
+     */
+    std::vector<Box> simple_sets;
+
+    StaticEvent() = default;
+
+    /**
+     * Construct an event from disjoint boxes. Empty boxes are dropped.
+     */
+    explicit StaticEvent(const std::vector<Box> &boxes) {
+        for (const auto &box: boxes) {
+            if (!box.is_empty()) {
+                simple_sets.push_back(box);
+            }
+        }
+    }
+
+    explicit StaticEvent(const Box &box) : StaticEvent(std::vector<Box>{box}) {}
+
+    [[nodiscard]] bool is_empty() const {
+        return simple_sets.empty();
+    }
+
+    /**
+     * @return The intersections of all pairs of boxes, which are disjoint.
+     */
+    [[nodiscard]] StaticEvent intersection_with(const StaticEvent &other) const {
+        StaticEvent result;
+        for (const auto &box: simple_sets) {
+            for (const auto &other_box: other.simple_sets) {
+                auto intersection = box.intersection_with(other_box);
+                if (!intersection.is_empty()) {
+                    result.simple_sets.push_back(std::move(intersection));
+                }
+            }
+        }
+        return result;
+    }
+
+    /**
+     * Remove the boxes of another event one after another.
+     *
+     * @return The disjoint difference.
+     */
+    [[nodiscard]] StaticEvent difference_with(const StaticEvent &other) const {
+        auto result = simple_sets;
+        for (const auto &other_box: other.simple_sets) {
+            std::vector<Box> remainder;
+            for (const auto &box: result) {
+                auto difference = box.difference_with(other_box);
+                remainder.insert(remainder.end(), std::make_move_iterator(difference.begin()),
+                                 std::make_move_iterator(difference.end()));
+            }
+            result = std::move(remainder);
+        }
+        return StaticEvent(result);
+    }
+
+    /**
+     * @return The disjoint union of this and the part of the other that is not in this.
+     */
+    [[nodiscard]] StaticEvent union_with(const StaticEvent &other) const {
+        auto result = *this;
+        auto remainder = other.difference_with(*this);
+        result.simple_sets.insert(result.simple_sets.end(), remainder.simple_sets.begin(),
+                                  remainder.simple_sets.end());
+        return result;
+    }
+
+    /**
+     * Form the complement within the domains of the dimensions, which are taken from the first box.
+     * The empty event has no box to take the domains from, so callers have to use `EventSchema::full_event` as its
+     * complement.
+     *
+     * @return The disjoint complement.
+     * @throws std::invalid_argument If this is empty.
+     */
+    [[nodiscard]] StaticEvent complement() const {
+        if (is_empty()) {
+            throw std::invalid_argument("The complement of an empty static event is undefined, since its domains "
+                                        "are unknown.");
+        }
+        return StaticEvent(simple_sets.front().full_box()).difference_with(*this);
+    }
+};
+
+/**
+ * Variables of static events, whose types are template parameters.
+ *
+ * The schema converts between `Event` and `StaticEvent` over its variables, such that schemas that are fixed at build
+ * time can run their set operations without looking up variables or visiting variants.
+ *
+ * @tparam T_Variables The types of the variables, which are `Continuous`, `Integer` or `Symbolic`.
+ */
+template<typename... T_Variables>
+class EventSchema {
+public:
+
+    using StaticSimpleEventType = StaticSimpleEvent<T_Variables...>;
+    using StaticEventType = StaticEvent<T_Variables...>;
+
+    static constexpr std::size_t dimensions = sizeof...(T_Variables);
+
+    /**
+     * The variable of every dimension.
+     */
+    std::tuple<T_Variables...> variables;
+
+    /**
+     * Construct a schema from variables with distinct names.
+     */
+    explicit EventSchema(T_Variables... variables) : variables(std::move(variables)...),
+                                                     domains(domains_of(Indices())) {
+        if (names_of(Indices()).size() != dimensions) {
+            throw std::invalid_argument("The variables of a schema must have distinct names.");
+        }
+    }
+
+    /**
+     * @return The box of the entire domains of all variables.
+     */
+    [[nodiscard]] StaticSimpleEventType full_box() const {
+        return StaticSimpleEventType(domains);
+    }
+
+    /**
+     * @return The event of the entire domains of all variables.
+     */
+    [[nodiscard]] StaticEventType full_event() const {
+        return StaticEventType(full_box());
+    }
+
+    /**
+     * Convert a simple event. Variables that it does not assign take their entire domain.
+     *
+     * @param simple_event The simple event, which may only assign the variables of this schema.
+     * @return The box of the simple event.
+     */
+    [[nodiscard]] StaticSimpleEventType from_simple_event(const SimpleEvent &simple_event) const {
+        StaticSimpleEventType result(domains);
+        auto assigned = from_simple_event(simple_event, result, Indices());
+        if (assigned != simple_event.variable_assignments.size()) {
+            throw std::invalid_argument("The simple event assigns a variable that is not in the schema.");
+        }
+        return result;
+    }
+
+    /**
+     * @return The simple event that assigns every variable of this schema.
+     */
+    [[nodiscard]] SimpleEvent to_simple_event(const StaticSimpleEventType &box) const {
+        SimpleEvent result;
+        to_simple_event(box, result, Indices());
+        return result;
+    }
+
+    /**
+     * Convert the boxes of an event, whose boxes have to be disjoint. Empty boxes are dropped.
+     */
+    [[nodiscard]] StaticEventType from_event(const Event &event) const {
+        std::vector<StaticSimpleEventType> boxes;
+        boxes.reserve(event.simple_sets.size());
+        for (const auto &simple_event: event.simple_sets) {
+            boxes.push_back(from_simple_event(simple_event));
+        }
+        return StaticEventType(boxes);
+    }
+
+    /**
+     * @return The event with one simple event per box.
+     */
+    [[nodiscard]] Event to_event(const StaticEventType &event) const {
+        Event result;
+        for (const auto &box: event.simple_sets) {
+            result.simple_sets.insert(to_simple_event(box));
+        }
+        return result;
+    }
+
+private:
+
+    using Indices = std::index_sequence_for<T_Variables...>;
+
+    /**
+     * The entire domain of every variable.
+     */
+    typename StaticSimpleEventType::Assignments domains;
+
+    template<std::size_t... I>
+    std::set<std::string> names_of(std::index_sequence<I...>) const {
+        return std::set<std::string>{std::get<I>(variables).name...};
+    }
+
+    template<std::size_t... I>
+    typename StaticSimpleEventType::Assignments domains_of(std::index_sequence<I...>) const {
+        return typename StaticSimpleEventType::Assignments(
+                std::get<typename std::tuple_element_t<I, typename StaticSimpleEventType::Assignments>>(
+                        full_domain_of(VisitVariableVariant(std::get<I>(variables))))...);
+    }
+
+    template<std::size_t... I>
+    std::size_t from_simple_event(const SimpleEvent &simple_event, StaticSimpleEventType &result,
+                                  std::index_sequence<I...>) const {
+        return (from_assignment<I>(simple_event, result) + ... + 0);
+    }
+
+    /**
+     * Copy the assignment of the variable of dimension I, if the simple event assigns it.
+     *
+     * @return 1 if the variable is assigned and 0 otherwise.
+     */
+    template<std::size_t I>
+    std::size_t from_assignment(const SimpleEvent &simple_event, StaticSimpleEventType &result) const {
+        using Dimension = std::tuple_element_t<I, typename StaticSimpleEventType::Assignments>;
+        auto assignment = simple_event.variable_assignments.find(VisitVariableVariant(std::get<I>(variables)));
+        if (assignment == simple_event.variable_assignments.end()) {
+            return 0;
+        }
+        if (!std::holds_alternative<Dimension>(assignment->second)) {
+            throw std::invalid_argument("The assignment of " + std::get<I>(variables).name +
+                                        " does not match the type of its variable.");
+        }
+        std::get<I>(result.assignments) = std::get<Dimension>(assignment->second);
+        return 1;
+    }
+
+    template<std::size_t... I>
+    void to_simple_event(const StaticSimpleEventType &box, SimpleEvent &result, std::index_sequence<I...>) const {
+        (result.variable_assignments.insert({VisitVariableVariant(std::get<I>(variables)),
+                                             std::get<I>(box.assignments)}), ...);
+    }
+};
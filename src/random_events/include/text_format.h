@@ -0,0 +1,193 @@
+#pragma once
+
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+#include "product_algebra.h"
+
+/**
+ * Buffer that formats sets as text.
+ *
+ * Numbers are written with `std::to_chars` in their shortest representation that parses back to the same float, which
+ * is independent of the locale. The syntax is the one of `to_string`:
+ *  - intervals: `[0, 1) u (2, inf)`
+ *  - sets: `a u b`
+ *  - events: `{x: [0, 1], a: a u b} u {x: (2, 3], a: c}`
+ *  - the empty set of every kind: `∅`
+ */
+class TextWriter {
+public:
+
+    void write(char character) {
+        buffer.push_back(character);
+    }
+
+    void write(std::string_view text) {
+        buffer.append(text);
+    }
+
+    void write(float value);
+
+    void write(const SimpleInterval &simple_interval);
+
+    void write(const Interval &interval);
+
+    void write(const Set &set);
+
+    void write(const SetVariant &set_variant);
+
+    void write(const SimpleEvent &simple_event);
+
+    void write(const Event &event);
+
+    /**
+     * @return The text written so far.
+     */
+    [[nodiscard]] const std::string &str() const {
+        return buffer;
+    }
+
+    /**
+     * @return The text written so far, which is moved out of this writer.
+     */
+    std::string release() {
+        return std::move(buffer);
+    }
+
+    void clear() {
+        buffer.clear();
+    }
+
+private:
+    std::string buffer;
+};
+
+/**
+ * @return The text representation of a set, simple set or set variant.
+ */
+template<typename T>
+std::string format(const T &value) {
+    TextWriter writer;
+    writer.write(value);
+    return writer.release();
+}
+
+std::ostream &operator<<(std::ostream &stream, const SimpleInterval &simple_interval);
+
+std::ostream &operator<<(std::ostream &stream, const Interval &interval);
+
+std::ostream &operator<<(std::ostream &stream, const Set &set);
+
+std::ostream &operator<<(std::ostream &stream, const SimpleEvent &simple_event);
+
+std::ostream &operator<<(std::ostream &stream, const Event &event);
+
+/**
+ * Parser for the text written by `TextWriter`.
+ *
+ * The parser reads from a view of the text and parses numbers with `std::from_chars`, such that the text is never
+ * copied. Spaces around tokens are optional. Elements of symbolic sets are the text up to the next ` u `, `,` or `}`
+ * and must therefore not contain these sequences.
+ * Malformed text raises a std::invalid_argument that contains the position of the error.
+ */
+class TextParser {
+public:
+
+    explicit TextParser(std::string_view text) : text(text) {}
+
+    SimpleInterval parse_simple_interval();
+
+    Interval parse_interval();
+
+    /**
+     * Parse a symbolic set.
+     *
+     * @param all_elements The elements of the domain of the set. Elements that are not in it are rejected.
+     */
+    Set parse_set(const SharedElements &all_elements);
+
+    /**
+     * Parse a simple event.
+     *
+     * @param variables The variables that may occur in the event, which are looked up by their name.
+     */
+    SimpleEvent parse_simple_event(const std::vector<VisitVariableVariant> &variables);
+
+    Event parse_event(const std::vector<VisitVariableVariant> &variables);
+
+    /**
+     * @return True if the entire text, except for trailing spaces, has been parsed.
+     */
+    [[nodiscard]] bool at_end();
+
+    /**
+     * @return The position of the next character to parse.
+     */
+    [[nodiscard]] std::size_t position() const {
+        return offset;
+    }
+
+private:
+
+    void skip_spaces();
+
+    /**
+     * Consume a token if the text continues with it.
+     * @return True if the token was consumed.
+     */
+    bool consume(std::string_view token);
+
+    /**
+     * Consume a token or throw if the text does not continue with it.
+     */
+    void expect(std::string_view token);
+
+    /**
+     * Consume the separator ` u ` of unions if it follows.
+     * @return True if the separator was consumed.
+     */
+    bool consume_union();
+
+    /**
+     * Parse a number, which has to be ordered, i. e. not NaN.
+     */
+    float parse_float();
+
+    /**
+     * Parse the set of a variable according to its type.
+     */
+    SetVariant parse_assignment(const VisitVariableVariant &variable);
+
+    /**
+     * @return The elements of a domain in ascending order, which is built once per domain and parser.
+     */
+    const std::vector<const std::string *> &index_of(const SharedElements &all_elements);
+
+    [[noreturn]] void fail(const std::string &message) const;
+
+    std::string_view text;
+    std::size_t offset = 0;
+
+    /**
+     * The indices of the domains of the sets parsed so far, such that elements are looked up by views of the text
+     * without copying them into strings.
+     */
+    std::vector<std::pair<SharedElements, std::vector<const std::string *>>> domain_indices;
+};
+
+/**
+ * @return The interval that makes up the entire text.
+ */
+Interval parse_interval(std::string_view text);
+
+/**
+ * @return The set that makes up the entire text.
+ */
+Set parse_set(std::string_view text, const SharedElements &all_elements);
+
+/**
+ * @return The event that makes up the entire text.
+ */
+Event parse_event(std::string_view text, const std::vector<VisitVariableVariant> &variables);
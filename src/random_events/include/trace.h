@@ -0,0 +1,114 @@
+#pragma once
+
+#include <chrono>
+#include <cstdio>
+#include <optional>
+#include <string>
+#include <variant>
+#include "product_algebra.h"
+
+/**
+ * Recording of the operations of intervals, sets and events for replaying them later.
+ *
+ * While recording, every intersection, union, difference, complement, make_disjoint, contains, is_disjoint and
+ * simplify that is called from outside of the library is written to a trace file together with its operands and
+ * duration. The differences of events and simple events are recorded as differences of events. Nested operations are
+ * part of the outer operation and are not recorded.
+ * Operations with arguments other than sets, such as project and coarsen, and the operations on lists of sets,
+ * union_all and intersection_all, are not recorded, since the format holds at most two operands of one kind. Their
+ * time is not attributed to any recorded operation either. Recording is off by default and costs a relaxed atomic load per operation
+ * while it is off.
+ *
+ * The trace is a binary file that starts with the magic bytes `RETRACE1`, followed by one record per operation:
+ *  - the operation and the kind of its operands as one byte each
+ *  - the duration in nanoseconds as 8 bytes
+ *  - the first operand and, for binary operations, the second operand
+ * Numbers are written in the byte order of the machine. Intervals are written as their number of simple intervals
+ * followed by lower bound, upper bound and a byte for the borders of each. Sets are written as their elements and
+ * their domain. Events are written as their simple events, which are written as their assignments of the kind and
+ * name of the variable and its set.
+ */
+
+/**
+ * An operand of a traced operation.
+ */
+using TraceOperand = std::variant<Interval, Set, Event>;
+
+/**
+ * The result of a replayed operation, which is a set or the answer of a predicate.
+ */
+using TraceResult = std::variant<Interval, Set, Event, bool>;
+
+/**
+ * A recorded operation.
+ */
+struct TraceRecord {
+    TracedOperation operation;
+    TraceOperand first;
+    std::optional<TraceOperand> second;
+    std::chrono::nanoseconds duration;
+
+    /**
+     * Run the operation again on the recorded operands.
+     * @return The result of the operation.
+     */
+    [[nodiscard]] TraceResult replay() const;
+};
+
+/**
+ * @return The name of an operation.
+ */
+std::string to_string(TracedOperation operation);
+
+/**
+ * Global recorder that writes the traced operations of all threads to a file.
+ */
+class TraceRecorder {
+public:
+
+    /**
+     * Start recording to a file, which is overwritten. A running recording is stopped first.
+     *
+     * @param path The path of the trace file.
+     */
+    static void start(const std::string &path);
+
+    /**
+     * Stop recording and close the trace file.
+     */
+    static void stop();
+
+    /**
+     * @return True if operations are recorded.
+     */
+    static bool is_recording() {
+        return operation_tracing_enabled.load(std::memory_order_relaxed);
+    }
+};
+
+/**
+ * Reader for trace files that reads one record after another.
+ */
+class TraceReader {
+public:
+
+    /**
+     * Open a trace file.
+     * @param path The path of the trace file.
+     */
+    explicit TraceReader(const std::string &path);
+
+    ~TraceReader();
+
+    TraceReader(const TraceReader &) = delete;
+
+    TraceReader &operator=(const TraceReader &) = delete;
+
+    /**
+     * @return The next record or nothing if the end of the trace is reached.
+     */
+    std::optional<TraceRecord> next();
+
+private:
+    std::FILE *file = nullptr;
+};
@@ -135,3 +135,21 @@ struct VisitVariableVariant {
     Symbolic operator()(Symbolic &v) { return std::get<Symbolic>(variable_variant); }
 
 };
+
+/**
+ * Hash function for variables. Variables are identified by their name.
+ */
+namespace std {
+    template<>
+    struct hash<VisitVariableVariant> {
+        size_t operator()(const VisitVariableVariant &variable) const {
+            return std::visit([](const auto &variable_) -> size_t {
+                if constexpr (std::is_same_v<std::decay_t<decltype(variable_)>, std::monostate>) {
+                    return 0;
+                } else {
+                    return hash<std::string>()(variable_.name);
+                }
+            }, variable.variable_variant);
+        }
+    };
+}
@@ -0,0 +1,98 @@
+#pragma once
+
+#include "persistent_set.h"
+#include "product_algebra.h"
+
+/**
+ * Event whose boxes are stored in a `PersistentSet`, such that every modification returns a new version in
+ * O(k log n) for k changed boxes out of n, which shares all other boxes with the version it was derived from.
+ *
+ * Search algorithms that derive many candidate refinements of one event can keep all of them alive at a cost that
+ * grows with the number of changed boxes instead of with the number of candidates times the size of the event.
+ * Versions are never modified, such that every version may be read by any number of threads.
+ */
+class VersionedEvent {
+public:
+
+    /**
+     * The boxes of this version.
+     */
+    PersistentSet<SimpleEvent> simple_sets;
+
+    VersionedEvent() = default;
+
+    /**
+     * Construct the first version of an event in O(n).
+     *
+     * @param event The event.
+     */
+    explicit VersionedEvent(const Event &event) : simple_sets(event.simple_sets.get()) {}
+
+    [[nodiscard]] bool is_empty() const {
+        return simple_sets.empty();
+    }
+
+    /**
+     * @return The number of boxes.
+     */
+    [[nodiscard]] std::size_t size() const {
+        return simple_sets.size();
+    }
+
+    /**
+     * Add a box, which has to be disjoint from the boxes of this version to keep the event disjoint.
+     *
+     * @param simple_event The box to add. Empty boxes are ignored.
+     * @return The new version.
+     */
+    [[nodiscard]] VersionedEvent with(const SimpleEvent &simple_event) const;
+
+    /**
+     * Remove a box.
+     *
+     * @param simple_event The box to remove.
+     * @return The new version, which is this version if it does not contain the box.
+     */
+    [[nodiscard]] VersionedEvent without(const SimpleEvent &simple_event) const;
+
+    /**
+     * Replace a box by a refinement, for instance a partition of the box.
+     *
+     * @param simple_event The box to replace.
+     * @param refinement The boxes that take its place.
+     * @return The new version.
+     */
+    [[nodiscard]] VersionedEvent replace(const SimpleEvent &simple_event, const Event &refinement) const;
+
+    /**
+     * Remove a simple event from every box that it intersects. Only these boxes are copied.
+     *
+     * @param other The simple event to remove.
+     * @return The new version, which is disjoint if this version is.
+     */
+    [[nodiscard]] VersionedEvent difference_with(const SimpleEvent &other) const;
+
+    /**
+     * Remove the boxes of an event one after another.
+     *
+     * @param other The event to remove.
+     * @return The new version.
+     */
+    [[nodiscard]] VersionedEvent difference_with(const Event &other) const;
+
+    /**
+     * @return The boxes of this version as ordinary event.
+     */
+    [[nodiscard]] Event to_event() const;
+
+    bool operator==(const VersionedEvent &other) const {
+        return simple_sets == other.simple_sets;
+    }
+
+    bool operator!=(const VersionedEvent &other) const {
+        return !(*this == other);
+    }
+
+private:
+    explicit VersionedEvent(PersistentSet<SimpleEvent> simple_sets) : simple_sets(std::move(simple_sets)) {}
+};
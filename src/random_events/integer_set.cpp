@@ -0,0 +1,620 @@
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include "integer_set.h"
+
+namespace {
+
+    /**
+     * The first and last value of a run within a chunk, both included.
+     */
+    using Run = std::pair<std::uint32_t, std::uint32_t>;
+
+    constexpr std::size_t ARRAY_LIMIT = 4096;
+    constexpr std::size_t BITMAP_BYTES = BitmapContainer::WORDS * sizeof(std::uint64_t);
+
+    enum class Operation {
+        UNION,
+        INTERSECTION,
+        DIFFERENCE
+    };
+
+    /**
+     * @return The value shifted such that the order of signed integers is the order of the unsigned keys.
+     */
+    std::uint32_t key_of(std::int32_t value) {
+        return static_cast<std::uint32_t>(value) ^ 0x80000000u;
+    }
+
+    std::int64_t value_of(std::uint16_t high, std::uint32_t low) {
+        return static_cast<std::int32_t>(((static_cast<std::uint32_t>(high) << 16) | low) ^ 0x80000000u);
+    }
+
+    /**
+     * @return The value as float, which the bounds of simple intervals are.
+     * @throws std::invalid_argument If the value has no exact float representation.
+     */
+    float exact_float(std::int64_t value) {
+        auto result = static_cast<float>(value);
+        if (static_cast<std::int64_t>(result) != value) {
+            throw std::invalid_argument("The integer " + std::to_string(value) +
+                                        " cannot be represented exactly as bound of an interval.");
+        }
+        return result;
+    }
+
+    std::uint32_t cardinality_of(const IntegerContainer &container) {
+        if (std::holds_alternative<ArrayContainer>(container)) {
+            return static_cast<std::uint32_t>(std::get<ArrayContainer>(container).values.size());
+        }
+        if (std::holds_alternative<BitmapContainer>(container)) {
+            return std::get<BitmapContainer>(container).cardinality;
+        }
+        std::uint32_t result = 0;
+        for (const auto &[first, length]: std::get<RunContainer>(container).runs) {
+            result += static_cast<std::uint32_t>(length) + 1;
+        }
+        return result;
+    }
+
+    bool container_contains(const IntegerContainer &container, std::uint16_t low) {
+        if (std::holds_alternative<ArrayContainer>(container)) {
+            const auto &values = std::get<ArrayContainer>(container).values;
+            return std::binary_search(values.begin(), values.end(), low);
+        }
+        if (std::holds_alternative<BitmapContainer>(container)) {
+            return (std::get<BitmapContainer>(container).words[low / 64] >> (low % 64)) & 1u;
+        }
+        const auto &runs = std::get<RunContainer>(container).runs;
+        auto run = std::upper_bound(runs.begin(), runs.end(), low, [](std::uint16_t value, const auto &current) {
+            return value < current.first;
+        });
+        if (run == runs.begin()) {
+            return false;
+        }
+        --run;
+        return low <= static_cast<std::uint32_t>(run->first) + run->second;
+    }
+
+    /**
+     * @return The number of values in the container that are smaller than or equal to low.
+     */
+    std::uint32_t container_rank(const IntegerContainer &container, std::uint16_t low) {
+        if (std::holds_alternative<ArrayContainer>(container)) {
+            const auto &values = std::get<ArrayContainer>(container).values;
+            return static_cast<std::uint32_t>(std::upper_bound(values.begin(), values.end(), low) - values.begin());
+        }
+        if (std::holds_alternative<BitmapContainer>(container)) {
+            const auto &words = std::get<BitmapContainer>(container).words;
+            std::uint32_t result = 0;
+            for (std::size_t i = 0; i < low / 64u; ++i) {
+                result += static_cast<std::uint32_t>(__builtin_popcountll(words[i]));
+            }
+            auto bits = low % 64u;
+            auto mask = bits == 63 ? ~std::uint64_t{0} : (std::uint64_t{1} << (bits + 1)) - 1;
+            return result + static_cast<std::uint32_t>(__builtin_popcountll(words[low / 64u] & mask));
+        }
+        std::uint32_t result = 0;
+        for (const auto &[first, length]: std::get<RunContainer>(container).runs) {
+            if (first > low) {
+                break;
+            }
+            result += std::min<std::uint32_t>(length, low - first) + 1;
+        }
+        return result;
+    }
+
+    std::vector<Run> runs_of(const IntegerContainer &container) {
+        std::vector<Run> result;
+        if (std::holds_alternative<ArrayContainer>(container)) {
+            for (auto value: std::get<ArrayContainer>(container).values) {
+                if (!result.empty() && result.back().second + 1 == value) {
+                    result.back().second = value;
+                } else {
+                    result.emplace_back(value, value);
+                }
+            }
+        } else if (std::holds_alternative<BitmapContainer>(container)) {
+            const auto &words = std::get<BitmapContainer>(container).words;
+            bool in_run = false;
+            for (std::uint32_t i = 0; i < BitmapContainer::WORDS; ++i) {
+                auto word = words[i];
+                // full and empty words continue or end the current run as a whole
+                if (word == 0 || word == ~std::uint64_t{0}) {
+                    if (word != 0 && !in_run) {
+                        result.emplace_back(64 * i, 0);
+                    }
+                    if (word != 0) {
+                        result.back().second = 64 * i + 63;
+                    }
+                    in_run = word != 0;
+                    continue;
+                }
+                for (std::uint32_t bit = 0; bit < 64; ++bit) {
+                    bool set = (word >> bit) & 1u;
+                    if (set && !in_run) {
+                        result.emplace_back(64 * i + bit, 0);
+                    }
+                    if (set) {
+                        result.back().second = 64 * i + bit;
+                    }
+                    in_run = set;
+                }
+            }
+        } else {
+            for (const auto &[first, length]: std::get<RunContainer>(container).runs) {
+                result.emplace_back(first, static_cast<std::uint32_t>(first) + length);
+            }
+        }
+        return result;
+    }
+
+    void set_range(BitmapContainer &bitmap, std::uint32_t first, std::uint32_t last) {
+        for (auto word = first / 64; word <= last / 64; ++word) {
+            auto from = word == first / 64 ? first % 64 : 0;
+            auto to = word == last / 64 ? last % 64 : 63;
+            auto mask = (to == 63 ? ~std::uint64_t{0} : (std::uint64_t{1} << (to + 1)) - 1) &
+                        ~((std::uint64_t{1} << from) - 1);
+            bitmap.words[word] |= mask;
+        }
+        bitmap.cardinality += last - first + 1;
+    }
+
+    BitmapContainer bitmap_of(const IntegerContainer &container) {
+        if (std::holds_alternative<BitmapContainer>(container)) {
+            return std::get<BitmapContainer>(container);
+        }
+        BitmapContainer result;
+        if (std::holds_alternative<ArrayContainer>(container)) {
+            for (auto value: std::get<ArrayContainer>(container).values) {
+                result.words[value / 64] |= std::uint64_t{1} << (value % 64);
+            }
+            result.cardinality = static_cast<std::uint32_t>(std::get<ArrayContainer>(container).values.size());
+            return result;
+        }
+        for (const auto &[first, last]: runs_of(container)) {
+            set_range(result, first, last);
+        }
+        return result;
+    }
+
+    /**
+     * @return The smallest representation for a chunk with the given number of values and runs.
+     */
+    ContainerKind smallest_kind(std::size_t cardinality, std::size_t number_of_runs) {
+        auto run_bytes = 2 * sizeof(std::uint16_t) * number_of_runs;
+        auto array_bytes = sizeof(std::uint16_t) * cardinality;
+        if (run_bytes < std::min(array_bytes, BITMAP_BYTES)) {
+            return ContainerKind::RUN;
+        }
+        return cardinality <= ARRAY_LIMIT ? ContainerKind::ARRAY : ContainerKind::BITMAP;
+    }
+
+    IntegerContainer compact_runs(const std::vector<Run> &runs) {
+        std::size_t cardinality = 0;
+        for (const auto &[first, last]: runs) {
+            cardinality += last - first + 1;
+        }
+
+        switch (smallest_kind(cardinality, runs.size())) {
+            case ContainerKind::RUN: {
+                RunContainer result;
+                result.runs.reserve(runs.size());
+                for (const auto &[first, last]: runs) {
+                    result.runs.emplace_back(static_cast<std::uint16_t>(first),
+                                             static_cast<std::uint16_t>(last - first));
+                }
+                return result;
+            }
+            case ContainerKind::ARRAY: {
+                ArrayContainer result;
+                result.values.reserve(cardinality);
+                for (const auto &[first, last]: runs) {
+                    for (auto value = first; value <= last; ++value) {
+                        result.values.push_back(static_cast<std::uint16_t>(value));
+                    }
+                }
+                return result;
+            }
+            default: {
+                BitmapContainer result;
+                for (const auto &[first, last]: runs) {
+                    set_range(result, first, last);
+                }
+                return result;
+            }
+        }
+    }
+
+    IntegerContainer compact_bitmap(BitmapContainer bitmap) {
+        // a run starts at every set bit whose predecessor is not set
+        std::size_t number_of_runs = 0;
+        std::uint64_t carry = 0;
+        for (auto word: bitmap.words) {
+            number_of_runs += static_cast<std::size_t>(__builtin_popcountll(word & ~((word << 1) | carry)));
+            carry = word >> 63;
+        }
+
+        auto kind = smallest_kind(bitmap.cardinality, number_of_runs);
+        if (kind == ContainerKind::BITMAP) {
+            return bitmap;
+        }
+        IntegerContainer container = std::move(bitmap);
+        return compact_runs(runs_of(container));
+    }
+
+    IntegerContainer compact_array(ArrayContainer array) {
+        IntegerContainer container = std::move(array);
+        auto runs = runs_of(container);
+        if (smallest_kind(cardinality_of(container), runs.size()) == ContainerKind::ARRAY) {
+            return container;
+        }
+        return compact_runs(runs);
+    }
+
+    std::vector<Run> combine_runs(const std::vector<Run> &first, const std::vector<Run> &second,
+                                  Operation operation) {
+        std::vector<Run> result;
+        if (operation == Operation::UNION) {
+            std::vector<Run> all;
+            all.reserve(first.size() + second.size());
+            std::merge(first.begin(), first.end(), second.begin(), second.end(), std::back_inserter(all));
+            for (const auto &run: all) {
+                if (!result.empty() && run.first <= result.back().second + 1) {
+                    result.back().second = std::max(result.back().second, run.second);
+                } else {
+                    result.push_back(run);
+                }
+            }
+            return result;
+        }
+
+        if (operation == Operation::INTERSECTION) {
+            std::size_t i = 0;
+            std::size_t j = 0;
+            while (i < first.size() && j < second.size()) {
+                auto lower = std::max(first[i].first, second[j].first);
+                auto upper = std::min(first[i].second, second[j].second);
+                if (lower <= upper) {
+                    result.emplace_back(lower, upper);
+                }
+                if (first[i].second < second[j].second) {
+                    ++i;
+                } else {
+                    ++j;
+                }
+            }
+            return result;
+        }
+
+        std::size_t j = 0;
+        for (auto [lower, upper]: first) {
+            while (j < second.size() && second[j].second < lower) {
+                ++j;
+            }
+            // cut the runs of second out of the current run
+            auto k = j;
+            bool remaining = true;
+            for (; k < second.size() && second[k].first <= upper; ++k) {
+                if (second[k].first > lower) {
+                    result.emplace_back(lower, second[k].first - 1);
+                }
+                if (second[k].second >= upper) {
+                    remaining = false;
+                    break;
+                }
+                lower = second[k].second + 1;
+            }
+            if (remaining) {
+                result.emplace_back(lower, upper);
+            }
+        }
+        return result;
+    }
+
+    IntegerContainer combine(const IntegerContainer &first, const IntegerContainer &second, Operation operation) {
+        if (std::holds_alternative<BitmapContainer>(first) || std::holds_alternative<BitmapContainer>(second)) {
+            auto result = bitmap_of(first);
+            auto other = bitmap_of(second);
+            result.cardinality = 0;
+            for (std::size_t i = 0; i < BitmapContainer::WORDS; ++i) {
+                switch (operation) {
+                    case Operation::UNION:
+                        result.words[i] |= other.words[i];
+                        break;
+                    case Operation::INTERSECTION:
+                        result.words[i] &= other.words[i];
+                        break;
+                    case Operation::DIFFERENCE:
+                        result.words[i] &= ~other.words[i];
+                        break;
+                }
+                result.cardinality += static_cast<std::uint32_t>(__builtin_popcountll(result.words[i]));
+            }
+            return compact_bitmap(std::move(result));
+        }
+
+        if (std::holds_alternative<ArrayContainer>(first) && std::holds_alternative<ArrayContainer>(second)) {
+            const auto &first_values = std::get<ArrayContainer>(first).values;
+            const auto &second_values = std::get<ArrayContainer>(second).values;
+            ArrayContainer result;
+            auto output = std::back_inserter(result.values);
+            switch (operation) {
+                case Operation::UNION:
+                    std::set_union(first_values.begin(), first_values.end(), second_values.begin(),
+                                   second_values.end(), output);
+                    break;
+                case Operation::INTERSECTION:
+                    std::set_intersection(first_values.begin(), first_values.end(), second_values.begin(),
+                                          second_values.end(), output);
+                    break;
+                case Operation::DIFFERENCE:
+                    std::set_difference(first_values.begin(), first_values.end(), second_values.begin(),
+                                        second_values.end(), output);
+                    break;
+            }
+            return compact_array(std::move(result));
+        }
+
+        return compact_runs(combine_runs(runs_of(first), runs_of(second), operation));
+    }
+}
+
+IntegerSet::IntegerSet(std::initializer_list<std::int32_t> values) {
+    for (auto value: values) {
+        insert(value);
+    }
+}
+
+IntegerSet IntegerSet::range(std::int32_t first, std::int32_t last) {
+    IntegerSet result;
+    if (first > last) {
+        return result;
+    }
+    auto first_key = key_of(first);
+    auto last_key = key_of(last);
+    for (auto high = first_key >> 16; high <= last_key >> 16; ++high) {
+        std::uint32_t lower = high == first_key >> 16 ? first_key & 0xffffu : 0;
+        std::uint32_t upper = high == last_key >> 16 ? last_key & 0xffffu : 0xffffu;
+        result.chunks.emplace_back(static_cast<std::uint16_t>(high), compact_runs({{lower, upper}}));
+    }
+    return result;
+}
+
+IntegerSet IntegerSet::from_interval(const Interval &interval) {
+    IntegerSet result;
+    for (const auto &simple_interval: interval.simple_sets) {
+        if (std::isinf(simple_interval.lower) || std::isinf(simple_interval.upper)) {
+            throw std::invalid_argument("Cannot convert an unbounded interval into an integer set.");
+        }
+
+        double first = std::ceil(simple_interval.lower);
+        if (first == simple_interval.lower && simple_interval.left == BorderType::OPEN) {
+            first += 1;
+        }
+        double last = std::floor(simple_interval.upper);
+        if (last == simple_interval.upper && simple_interval.right == BorderType::OPEN) {
+            last -= 1;
+        }
+        if (last < first) {
+            continue;
+        }
+        if (first < std::numeric_limits<std::int32_t>::min() || last > std::numeric_limits<std::int32_t>::max()) {
+            throw std::invalid_argument("The interval exceeds the range of 32-bit integers.");
+        }
+        result = result.union_with(range(static_cast<std::int32_t>(first), static_cast<std::int32_t>(last)));
+    }
+    return result;
+}
+
+Interval IntegerSet::to_interval() const {
+    SimpleSetType<SimpleInterval> result;
+    bool in_run = false;
+    std::int64_t run_first = 0;
+    std::int64_t run_last = 0;
+
+    // runs that continue in the next chunk are merged
+    for (const auto &[high, container]: chunks) {
+        for (const auto &[first, last]: runs_of(container)) {
+            auto first_value = value_of(high, first);
+            if (in_run && first_value == run_last + 1) {
+                run_last = value_of(high, last);
+                continue;
+            }
+            if (in_run) {
+                result.insert(SimpleInterval(exact_float(run_first), exact_float(run_last),
+                                             BorderType::CLOSED, BorderType::CLOSED));
+            }
+            in_run = true;
+            run_first = first_value;
+            run_last = value_of(high, last);
+        }
+    }
+    if (in_run) {
+        result.insert(SimpleInterval(exact_float(run_first), exact_float(run_last),
+                                     BorderType::CLOSED, BorderType::CLOSED));
+    }
+    return Interval(result);
+}
+
+void IntegerSet::insert(std::int32_t value) {
+    auto key = key_of(value);
+    auto high = static_cast<std::uint16_t>(key >> 16);
+    auto low = static_cast<std::uint16_t>(key & 0xffffu);
+
+    auto chunk = std::lower_bound(chunks.begin(), chunks.end(), high, [](const auto &current, std::uint16_t h) {
+        return current.first < h;
+    });
+    if (chunk == chunks.end() || chunk->first != high) {
+        chunks.insert(chunk, {high, ArrayContainer{{low}}});
+        return;
+    }
+
+    auto &container = chunk->second;
+    if (std::holds_alternative<ArrayContainer>(container)) {
+        auto &values = std::get<ArrayContainer>(container).values;
+        auto position = std::lower_bound(values.begin(), values.end(), low);
+        if (position != values.end() && *position == low) {
+            return;
+        }
+        values.insert(position, low);
+        if (values.size() > ARRAY_LIMIT) {
+            container = compact_array(std::move(std::get<ArrayContainer>(container)));
+        }
+    } else if (std::holds_alternative<BitmapContainer>(container)) {
+        auto &bitmap = std::get<BitmapContainer>(container);
+        auto bit = std::uint64_t{1} << (low % 64);
+        if (!(bitmap.words[low / 64] & bit)) {
+            bitmap.words[low / 64] |= bit;
+            ++bitmap.cardinality;
+        }
+    } else if (!container_contains(container, low)) {
+        container = compact_runs(combine_runs(runs_of(container), {{low, low}}, Operation::UNION));
+    }
+}
+
+bool IntegerSet::contains(std::int32_t value) const {
+    auto key = key_of(value);
+    auto high = static_cast<std::uint16_t>(key >> 16);
+    auto chunk = std::lower_bound(chunks.begin(), chunks.end(), high, [](const auto &current, std::uint16_t h) {
+        return current.first < h;
+    });
+    return chunk != chunks.end() && chunk->first == high &&
+           container_contains(chunk->second, static_cast<std::uint16_t>(key & 0xffffu));
+}
+
+std::uint64_t IntegerSet::cardinality() const {
+    std::uint64_t result = 0;
+    for (const auto &[high, container]: chunks) {
+        result += cardinality_of(container);
+    }
+    return result;
+}
+
+std::uint64_t IntegerSet::rank(std::int32_t value) const {
+    auto key = key_of(value);
+    auto high = static_cast<std::uint16_t>(key >> 16);
+    std::uint64_t result = 0;
+    for (const auto &[chunk_high, container]: chunks) {
+        if (chunk_high > high) {
+            break;
+        }
+        result += chunk_high < high ? cardinality_of(container)
+                                    : container_rank(container, static_cast<std::uint16_t>(key & 0xffffu));
+    }
+    return result;
+}
+
+IntegerSet IntegerSet::union_with(const IntegerSet &other) const {
+    IntegerSet result;
+    result.chunks.reserve(chunks.size() + other.chunks.size());
+    std::size_t i = 0;
+    std::size_t j = 0;
+    while (i < chunks.size() || j < other.chunks.size()) {
+        if (j == other.chunks.size() || (i < chunks.size() && chunks[i].first < other.chunks[j].first)) {
+            result.chunks.push_back(chunks[i++]);
+        } else if (i == chunks.size() || other.chunks[j].first < chunks[i].first) {
+            result.chunks.push_back(other.chunks[j++]);
+        } else {
+            result.chunks.emplace_back(chunks[i].first,
+                                       combine(chunks[i].second, other.chunks[j].second, Operation::UNION));
+            ++i;
+            ++j;
+        }
+    }
+    return result;
+}
+
+IntegerSet IntegerSet::intersection_with(const IntegerSet &other) const {
+    IntegerSet result;
+    std::size_t i = 0;
+    std::size_t j = 0;
+    while (i < chunks.size() && j < other.chunks.size()) {
+        if (chunks[i].first < other.chunks[j].first) {
+            ++i;
+        } else if (other.chunks[j].first < chunks[i].first) {
+            ++j;
+        } else {
+            auto container = combine(chunks[i].second, other.chunks[j].second, Operation::INTERSECTION);
+            if (cardinality_of(container) > 0) {
+                result.chunks.emplace_back(chunks[i].first, std::move(container));
+            }
+            ++i;
+            ++j;
+        }
+    }
+    return result;
+}
+
+IntegerSet IntegerSet::difference_with(const IntegerSet &other) const {
+    IntegerSet result;
+    std::size_t j = 0;
+    for (const auto &[high, container]: chunks) {
+        while (j < other.chunks.size() && other.chunks[j].first < high) {
+            ++j;
+        }
+        if (j == other.chunks.size() || other.chunks[j].first != high) {
+            result.chunks.emplace_back(high, container);
+            continue;
+        }
+        auto difference = combine(container, other.chunks[j].second, Operation::DIFFERENCE);
+        if (cardinality_of(difference) > 0) {
+            result.chunks.emplace_back(high, std::move(difference));
+        }
+    }
+    return result;
+}
+
+std::vector<std::int32_t> IntegerSet::to_vector() const {
+    std::vector<std::int32_t> result;
+    result.reserve(cardinality());
+    for (const auto &[high, container]: chunks) {
+        for (const auto &[first, last]: runs_of(container)) {
+            for (auto low = first; low <= last; ++low) {
+                result.push_back(static_cast<std::int32_t>(value_of(high, low)));
+            }
+        }
+    }
+    return result;
+}
+
+std::vector<ContainerKind> IntegerSet::container_kinds() const {
+    std::vector<ContainerKind> result;
+    result.reserve(chunks.size());
+    for (const auto &[high, container]: chunks) {
+        result.push_back(static_cast<ContainerKind>(container.index()));
+    }
+    return result;
+}
+
+MemoryFootprint IntegerSet::memory_footprint() const {
+    MemoryFootprint result;
+    result.container_nodes += chunks.capacity() * sizeof(decltype(chunks)::value_type);
+    for (const auto &[high, container]: chunks) {
+        if (std::holds_alternative<ArrayContainer>(container)) {
+            result.container_nodes += std::get<ArrayContainer>(container).values.capacity() * sizeof(std::uint16_t);
+        } else if (std::holds_alternative<BitmapContainer>(container)) {
+            result.container_nodes += BITMAP_BYTES;
+        } else {
+            result.container_nodes += std::get<RunContainer>(container).runs.capacity() *
+                                      sizeof(std::pair<std::uint16_t, std::uint16_t>);
+        }
+    }
+    return result;
+}
+
+bool IntegerSet::operator==(const IntegerSet &other) const {
+    if (chunks.size() != other.chunks.size()) {
+        return false;
+    }
+    // the same values may be held by different containers
+    for (std::size_t i = 0; i < chunks.size(); ++i) {
+        if (chunks[i].first != other.chunks[i].first ||
+            runs_of(chunks[i].second) != runs_of(other.chunks[i].second)) {
+            return false;
+        }
+    }
+    return true;
+}
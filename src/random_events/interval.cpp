@@ -3,7 +3,9 @@
 #include <stdexcept>
 #include <algorithm>
 #include <iostream>
+#include <queue>
 #include "interval.h"
+#include "overlap_kernel.h"
 #include "sigma_algebra.h"
 
 SimpleInterval SimpleInterval::simple_set_intersection_with(const SimpleInterval &other) const {
@@ -42,15 +44,29 @@ SimpleInterval SimpleInterval::simple_set_intersection_with(const SimpleInterval
 }
 
 Interval SimpleInterval::simple_set_complement() const {
-    const SimpleSetType<SimpleInterval> resulting_intervals = {
-            SimpleInterval{-std::numeric_limits<float>::infinity(),
-                           lower,
-                           BorderType::OPEN,
-                           invert_border(left)},
-            SimpleInterval{upper,
-                           std::numeric_limits<float>::infinity(),
-                           invert_border(right),
-                           BorderType::OPEN}};
+
+    // the complement of the empty interval are the real numbers
+    if (is_empty()) {
+        return reals();
+    }
+
+    auto left_of_this = SimpleInterval{-std::numeric_limits<float>::infinity(),
+                                       lower,
+                                       BorderType::OPEN,
+                                       invert_border(left)};
+    auto right_of_this = SimpleInterval{upper,
+                                        std::numeric_limits<float>::infinity(),
+                                        invert_border(right),
+                                        BorderType::OPEN};
+
+    // skip the parts that vanish at infinity
+    SimpleSetType<SimpleInterval> resulting_intervals;
+    if (!left_of_this.is_empty()) {
+        resulting_intervals.insert(left_of_this);
+    }
+    if (!right_of_this.is_empty()) {
+        resulting_intervals.insert(right_of_this);
+    }
     return Interval(resulting_intervals);
 }
 
@@ -74,11 +90,11 @@ SimpleInterval::SimpleInterval(float lower, float upper, BorderType left, Border
     if (lower > upper) { throw std::invalid_argument("Lower bound must be less than or equal to upper bound."); }
 }
 
-SimpleInterval::operator std::string() {
+SimpleInterval::operator std::string() const {
     return to_string();
 }
 
-std::string SimpleInterval::to_string() {
+std::string SimpleInterval::to_string() const {
     if (is_empty()) {
         return "∅";
     }
@@ -89,21 +105,272 @@ std::string SimpleInterval::to_string() {
 }
 
 Interval Interval::composite_set_simplify() {
+    if (is_empty()) {
+        return *this;
+    }
     std::vector<SimpleInterval> result;
-    auto sorted = simple_sets_as_vector();
 
-    std::sort(sorted.begin(), sorted.end());
-    result.push_back(sorted[0]);
+    // the simple intervals are stored in ascending order
+    result.push_back(*simple_sets.begin());
 
-    for (auto current_simple_interval = sorted.begin() + 1; current_simple_interval != sorted.end(); ++current_simple_interval) {
+    for (auto current_simple_interval = std::next(simple_sets.begin()); current_simple_interval != simple_sets.end(); ++current_simple_interval) {
         auto last_simple_interval = result.back();
         if (last_simple_interval.upper == current_simple_interval->lower &&
             !(last_simple_interval.right == BorderType::OPEN and current_simple_interval->left == BorderType::OPEN)) {
             result.pop_back();
-            result.emplace_back(last_simple_interval.lower, current_simple_interval->upper, last_simple_interval.left, current_simple_interval->right);
+            result.push_back(SimpleInterval{last_simple_interval.lower, current_simple_interval->upper, last_simple_interval.left, current_simple_interval->right});
         } else {
             result.push_back(*current_simple_interval);
         }
     }
     return Interval(SimpleSetType<SimpleInterval> (result.begin(), result.end()));
 }
+
+double Interval::measure() const {
+    double result = 0;
+    for (const auto &simple_interval: simple_sets) {
+        result += static_cast<double>(simple_interval.upper) - simple_interval.lower;
+    }
+    return result;
+}
+
+std::tuple<Interval, double> Interval::coarsen(std::size_t max_pieces, float epsilon) const {
+    if (max_pieces == 0) {
+        throw std::invalid_argument("The number of pieces has to be positive.");
+    }
+    if (simple_sets.size() <= 1) {
+        return {*this, 0.};
+    }
+
+    // the gap i lies between piece i and i + 1
+    std::vector<float> gaps;
+    gaps.reserve(simple_sets.size() - 1);
+    for (auto piece = simple_sets.begin(); std::next(piece) != simple_sets.end(); ++piece) {
+        gaps.push_back(std::next(piece)->lower - piece->upper);
+    }
+
+    // keep the largest gaps that are at least epsilon, such that at most max_pieces remain
+    std::vector<std::size_t> order(gaps.size());
+    for (std::size_t i = 0; i < order.size(); ++i) {
+        order[i] = i;
+    }
+    std::stable_sort(order.begin(), order.end(), [&gaps](std::size_t first, std::size_t second) {
+        return gaps[first] > gaps[second];
+    });
+    std::vector<bool> keep_gap(gaps.size(), false);
+    for (std::size_t rank = 0; rank < order.size() && rank + 1 < max_pieces; ++rank) {
+        if (gaps[order[rank]] < epsilon) {
+            break;
+        }
+        keep_gap[order[rank]] = true;
+    }
+
+    // merge the pieces across all closed gaps
+    SimpleSetType<SimpleInterval> result;
+    double error = 0;
+    auto next_piece = simple_sets.begin();
+    SimpleInterval current = *next_piece;
+    for (std::size_t i = 0; i < gaps.size(); ++i) {
+        ++next_piece;
+        if (keep_gap[i]) {
+            result.insert(current);
+            current = *next_piece;
+            continue;
+        }
+        error += gaps[i];
+        current = SimpleInterval{current.lower, next_piece->upper, current.left, next_piece->right};
+    }
+    result.insert(current);
+    return {Interval(result), error};
+}
+
+Interval Interval::intersection_with(const Interval &other) const {
+    OperationTimer<Interval> timer(TracedOperation::INTERSECTION, *this, &other);
+    if (bounding_hulls_disjoint(other)) {
+        return {};
+    }
+    SimpleIntervalColumns intersections;
+    intersect_columns(SimpleIntervalColumns(*this), SimpleIntervalColumns(other), intersections);
+
+    Interval result;
+    for (std::size_t i = 0; i < intersections.size(); ++i) {
+        result.simple_sets.insert(intersections.at(i));
+    }
+    return result;
+}
+
+std::vector<std::vector<std::size_t>> Interval::overlapping_simple_sets() const {
+    std::vector<IndexPair> pairs;
+    overlapping_pairs_within(SimpleIntervalColumns(*this), pairs);
+
+    std::vector<std::vector<std::size_t>> result(simple_sets.size());
+    for (const auto &[i, j]: pairs) {
+        result[i].push_back(j);
+        result[j].push_back(i);
+    }
+    return result;
+}
+
+bool Interval::is_disjoint() const {
+    OperationTimer<Interval> timer(TracedOperation::IS_DISJOINT, *this);
+    if (simple_sets.empty()) {
+        return true;
+    }
+
+    // the piece with the largest upper bound so far, where closed upper bounds reach further than open ones
+    auto furthest = simple_sets.begin();
+    for (auto current = std::next(simple_sets.begin()); current != simple_sets.end(); ++current) {
+        if (!furthest->intersection_with(*current).is_empty()) {
+            return false;
+        }
+        if (current->upper > furthest->upper ||
+            (current->upper == furthest->upper && current->right == BorderType::CLOSED)) {
+            furthest = current;
+        }
+    }
+    return true;
+}
+
+namespace {
+
+    /**
+     * @return True if the simple interval reaches at least as far to the right as the other one, where closed upper
+     * bounds reach further than open ones.
+     */
+    bool reaches_further(const SimpleInterval &simple_interval, const SimpleInterval &other) {
+        return simple_interval.upper > other.upper ||
+               (simple_interval.upper == other.upper &&
+                (simple_interval.right == BorderType::CLOSED || other.right == BorderType::OPEN));
+    }
+
+    /**
+     * Intersect two disjoint intervals by walking through both in ascending order.
+     */
+    Interval intersect_sorted(const Interval &first, const Interval &second) {
+        std::vector<SimpleInterval> result;
+        auto first_iterator = first.simple_sets.begin();
+        auto second_iterator = second.simple_sets.begin();
+        while (first_iterator != first.simple_sets.end() && second_iterator != second.simple_sets.end()) {
+            auto intersection = first_iterator->intersection_with(*second_iterator);
+            if (!intersection.is_empty()) {
+                result.push_back(intersection);
+            }
+
+            // the simple interval that ends first cannot intersect any later simple interval of the other one
+            bool first_reaches_further = reaches_further(*first_iterator, *second_iterator);
+            bool second_reaches_further = reaches_further(*second_iterator, *first_iterator);
+            if (!first_reaches_further || second_reaches_further) {
+                ++first_iterator;
+            }
+            if (!second_reaches_further || first_reaches_further) {
+                ++second_iterator;
+            }
+        }
+        return Interval(SimpleSetType<SimpleInterval>(result.begin(), result.end()));
+    }
+}
+
+Interval union_all(const std::vector<Interval> &intervals) {
+    using Cursor = std::pair<SimpleSetType<SimpleInterval>::const_iterator,
+            SimpleSetType<SimpleInterval>::const_iterator>;
+    auto greater = [](const Cursor &first, const Cursor &second) {
+        return *second.first < *first.first;
+    };
+    std::priority_queue<Cursor, std::vector<Cursor>, decltype(greater)> cursors(greater);
+    for (const auto &interval: intervals) {
+        if (!interval.simple_sets.empty()) {
+            cursors.emplace(interval.simple_sets.begin(), interval.simple_sets.end());
+        }
+    }
+
+    std::vector<SimpleInterval> result;
+    while (!cursors.empty()) {
+        auto [next, end] = cursors.top();
+        cursors.pop();
+        auto simple_interval = *next;
+        if (++next != end) {
+            cursors.emplace(next, end);
+        }
+        if (simple_interval.is_empty()) {
+            continue;
+        }
+
+        // start a new simple interval if the next one neither overlaps nor touches the last one
+        if (result.empty() || simple_interval.lower > result.back().upper ||
+            (simple_interval.lower == result.back().upper && simple_interval.left == BorderType::OPEN &&
+             result.back().right == BorderType::OPEN)) {
+            result.push_back(simple_interval);
+            continue;
+        }
+
+        auto &last = result.back();
+        if (simple_interval.lower == last.lower && simple_interval.left == BorderType::CLOSED) {
+            last.left = BorderType::CLOSED;
+        }
+        if (reaches_further(simple_interval, last)) {
+            last.upper = simple_interval.upper;
+            last.right = simple_interval.right;
+        }
+    }
+    return Interval(SimpleSetType<SimpleInterval>(result.begin(), result.end()));
+}
+
+Interval intersection_all(const std::vector<Interval> &intervals) {
+    if (intervals.empty()) {
+        return reals();
+    }
+
+    // intersecting the smallest intervals first keeps the intermediate results small
+    std::vector<const Interval *> order;
+    order.reserve(intervals.size());
+    for (const auto &interval: intervals) {
+        order.push_back(&interval);
+    }
+    std::stable_sort(order.begin(), order.end(), [](const Interval *first, const Interval *second) {
+        return first->simple_sets.size() < second->simple_sets.size();
+    });
+
+    auto disjoint = [](const Interval &interval) {
+        return interval.is_disjoint() ? interval : interval.make_disjoint();
+    };
+    auto result = disjoint(*order.front());
+    for (auto interval = std::next(order.begin()); interval != order.end() && !result.is_empty(); ++interval) {
+        result = intersect_sorted(result, disjoint(**interval));
+    }
+    return result.simplify();
+}
+
+const SimpleInterval &Interval::bounding_hull() const {
+    return simple_sets.bounding_hull([](const SimpleSetType<SimpleInterval> &simple_intervals) {
+        SimpleInterval result;
+        for (const auto &simple_interval: simple_intervals) {
+            if (simple_interval.is_empty()) {
+                continue;
+            }
+            if (result.is_empty()) {
+                result = simple_interval;
+                continue;
+            }
+
+            // the simple intervals are ordered by their lower bound
+            if (simple_interval.lower == result.lower && simple_interval.left == BorderType::CLOSED) {
+                result.left = BorderType::CLOSED;
+            }
+            if (reaches_further(simple_interval, result)) {
+                result.upper = simple_interval.upper;
+                result.right = simple_interval.right;
+            }
+        }
+        return result;
+    });
+}
+
+bool Interval::bounding_hulls_disjoint(const Interval &other) const {
+    return bounding_hull().intersection_with(other.bounding_hull()).is_empty();
+}
+
+bool Interval::bounding_hull_contains(const Interval &other) const {
+    const auto &hull = bounding_hull();
+    const auto &other_hull = other.bounding_hull();
+    return hull.intersection_with(other_hull) == other_hull;
+}
@@ -0,0 +1,123 @@
+#include <algorithm>
+#include <cmath>
+#include "interval_index.h"
+
+IntervalIndex::IntervalIndex(const std::vector<Interval> &intervals) : number_of_intervals(intervals.size()) {
+    std::vector<Entry> entries;
+    for (std::size_t id = 0; id < intervals.size(); ++id) {
+        for (const auto &simple_interval: intervals[id].simple_sets) {
+            if (!simple_interval.is_empty()) {
+                entries.push_back(Entry{simple_interval, id});
+            }
+        }
+    }
+    root = build(std::move(entries));
+}
+
+std::ptrdiff_t IntervalIndex::build(std::vector<Entry> entries) {
+    if (entries.empty()) {
+        return -1;
+    }
+
+    // the center is the median of the finite bounds, such that at least one piece overlaps it
+    std::vector<float> bounds;
+    bounds.reserve(2 * entries.size());
+    for (const auto &entry: entries) {
+        if (std::isfinite(entry.simple_interval.lower)) {
+            bounds.push_back(entry.simple_interval.lower);
+        }
+        if (std::isfinite(entry.simple_interval.upper)) {
+            bounds.push_back(entry.simple_interval.upper);
+        }
+    }
+    float center = 0;
+    if (!bounds.empty()) {
+        auto median = bounds.begin() + static_cast<std::ptrdiff_t>(bounds.size() / 2);
+        std::nth_element(bounds.begin(), median, bounds.end());
+        center = *median;
+    }
+
+    // partition the pieces into those left of, overlapping and right of the center
+    std::vector<Entry> left_entries;
+    std::vector<Entry> right_entries;
+    Node node;
+    node.center = center;
+    for (auto &entry: entries) {
+        if (entry.simple_interval.upper < center) {
+            left_entries.push_back(entry);
+        } else if (entry.simple_interval.lower > center) {
+            right_entries.push_back(entry);
+        } else {
+            node.by_lower.push_back(entry);
+        }
+    }
+    node.by_upper = node.by_lower;
+    std::sort(node.by_lower.begin(), node.by_lower.end(), [](const Entry &first, const Entry &second) {
+        return first.simple_interval.lower < second.simple_interval.lower;
+    });
+    std::sort(node.by_upper.begin(), node.by_upper.end(), [](const Entry &first, const Entry &second) {
+        return first.simple_interval.upper > second.simple_interval.upper;
+    });
+
+    auto position = static_cast<std::ptrdiff_t>(nodes.size());
+    nodes.push_back(std::move(node));
+
+    // the children are built after the parent is stored, since building them reallocates the node vector
+    auto left = build(std::move(left_entries));
+    auto right = build(std::move(right_entries));
+    nodes[position].left = left;
+    nodes[position].right = right;
+    return position;
+}
+
+void IntervalIndex::stab(float value, std::vector<std::size_t> &result) const {
+    auto current = root;
+    while (current != -1) {
+        const auto &node = nodes[current];
+
+        if (value < node.center) {
+            // every piece with a lower bound below the value contains it, since it also reaches the center
+            for (const auto &entry: node.by_lower) {
+                if (entry.simple_interval.lower > value) {
+                    break;
+                }
+                if (entry.simple_interval.contains(value)) {
+                    result.push_back(entry.id);
+                }
+            }
+            current = node.left;
+        } else if (value > node.center) {
+            // every piece with an upper bound above the value contains it, since it also reaches the center
+            for (const auto &entry: node.by_upper) {
+                if (entry.simple_interval.upper < value) {
+                    break;
+                }
+                if (entry.simple_interval.contains(value)) {
+                    result.push_back(entry.id);
+                }
+            }
+            current = node.right;
+        } else {
+            for (const auto &entry: node.by_lower) {
+                if (entry.simple_interval.contains(value)) {
+                    result.push_back(entry.id);
+                }
+            }
+            return;
+        }
+    }
+}
+
+std::vector<std::size_t> IntervalIndex::stab(float value) const {
+    std::vector<std::size_t> result;
+    stab(value, result);
+    return result;
+}
+
+std::vector<std::vector<std::size_t>> IntervalIndex::stab_all(const std::vector<float> &values) const {
+    std::vector<std::vector<std::size_t>> result(values.size());
+    for (std::size_t i = 0; i < values.size(); ++i) {
+        stab(values[i], result[i]);
+    }
+    return result;
+}
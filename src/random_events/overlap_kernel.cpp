@@ -0,0 +1,184 @@
+#include <algorithm>
+#include "overlap_kernel.h"
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define RANDOM_EVENTS_AVX2_KERNEL 1
+#include <immintrin.h>
+#endif
+
+namespace {
+
+    /**
+     * Check if two simple intervals whose bounds meet in exactly one point share that point.
+     */
+    bool touching_intervals_overlap(const SimpleIntervalColumns &first, std::size_t i,
+                                    const SimpleIntervalColumns &second, std::size_t j) {
+        bool left_closed;
+        if (first.lower[i] == second.lower[j]) {
+            left_closed = (first.borders[i] & second.borders[j] & SimpleIntervalColumns::LEFT_CLOSED) != 0;
+        } else if (first.lower[i] > second.lower[j]) {
+            left_closed = (first.borders[i] & SimpleIntervalColumns::LEFT_CLOSED) != 0;
+        } else {
+            left_closed = (second.borders[j] & SimpleIntervalColumns::LEFT_CLOSED) != 0;
+        }
+
+        bool right_closed;
+        if (first.upper[i] == second.upper[j]) {
+            right_closed = (first.borders[i] & second.borders[j] & SimpleIntervalColumns::RIGHT_CLOSED) != 0;
+        } else if (first.upper[i] < second.upper[j]) {
+            right_closed = (first.borders[i] & SimpleIntervalColumns::RIGHT_CLOSED) != 0;
+        } else {
+            right_closed = (second.borders[j] & SimpleIntervalColumns::RIGHT_CLOSED) != 0;
+        }
+        return left_closed && right_closed;
+    }
+
+}
+
+bool simple_intervals_overlap(const SimpleIntervalColumns &first, std::size_t i,
+                              const SimpleIntervalColumns &second, std::size_t j) {
+    float new_lower = std::max(first.lower[i], second.lower[j]);
+    float new_upper = std::min(first.upper[i], second.upper[j]);
+    if (new_lower < new_upper) {
+        return true;
+    }
+    if (new_lower > new_upper) {
+        return false;
+    }
+    return touching_intervals_overlap(first, i, second, j);
+}
+
+SimpleIntervalColumns::SimpleIntervalColumns(const Interval &interval) {
+    reserve(interval.simple_sets.size());
+    for (const auto &simple_interval: interval.simple_sets) {
+        push_back(simple_interval);
+    }
+}
+
+void SimpleIntervalColumns::push_back(const SimpleInterval &simple_interval) {
+    lower.push_back(simple_interval.lower);
+    upper.push_back(simple_interval.upper);
+    borders.push_back(static_cast<std::uint8_t>((simple_interval.left == BorderType::CLOSED ? LEFT_CLOSED : 0) |
+                                                (simple_interval.right == BorderType::CLOSED ? RIGHT_CLOSED : 0)));
+}
+
+SimpleInterval SimpleIntervalColumns::at(std::size_t position) const {
+    return SimpleInterval{lower[position], upper[position],
+                          (borders[position] & LEFT_CLOSED) ? BorderType::CLOSED : BorderType::OPEN,
+                          (borders[position] & RIGHT_CLOSED) ? BorderType::CLOSED : BorderType::OPEN};
+}
+
+void SimpleIntervalColumns::reserve(std::size_t size) {
+    lower.reserve(size);
+    upper.reserve(size);
+    borders.reserve(size);
+}
+
+bool avx2_available() {
+#ifdef RANDOM_EVENTS_AVX2_KERNEL
+    static const bool available = __builtin_cpu_supports("avx2");
+    return available;
+#else
+    return false;
+#endif
+}
+
+void overlapping_pairs_scalar(const SimpleIntervalColumns &first, const SimpleIntervalColumns &second,
+                              std::vector<IndexPair> &pairs, bool only_upper_triangle) {
+    for (std::size_t i = 0; i < first.size(); ++i) {
+        for (std::size_t j = only_upper_triangle ? i + 1 : 0; j < second.size(); ++j) {
+            if (simple_intervals_overlap(first, i, second, j)) {
+                pairs.emplace_back(static_cast<std::uint32_t>(i), static_cast<std::uint32_t>(j));
+            }
+        }
+    }
+}
+
+#ifdef RANDOM_EVENTS_AVX2_KERNEL
+__attribute__((target("avx2")))
+void overlapping_pairs_avx2(const SimpleIntervalColumns &first, const SimpleIntervalColumns &second,
+                            std::vector<IndexPair> &pairs, bool only_upper_triangle) {
+    const std::size_t size = second.size();
+    for (std::size_t i = 0; i < first.size(); ++i) {
+        const __m256 lower_i = _mm256_set1_ps(first.lower[i]);
+        const __m256 upper_i = _mm256_set1_ps(first.upper[i]);
+
+        std::size_t j = only_upper_triangle ? i + 1 : 0;
+        for (; j + 8 <= size; j += 8) {
+            const __m256 new_lower = _mm256_max_ps(lower_i, _mm256_loadu_ps(second.lower.data() + j));
+            const __m256 new_upper = _mm256_min_ps(upper_i, _mm256_loadu_ps(second.upper.data() + j));
+            auto overlapping = static_cast<unsigned>(_mm256_movemask_ps(
+                    _mm256_cmp_ps(new_lower, new_upper, _CMP_LT_OQ)));
+            auto touching = static_cast<unsigned>(_mm256_movemask_ps(
+                    _mm256_cmp_ps(new_lower, new_upper, _CMP_EQ_OQ)));
+
+            // only touching lanes need a look at the borders
+            auto candidates = overlapping | touching;
+            while (candidates != 0) {
+                auto lane = static_cast<std::size_t>(__builtin_ctz(candidates));
+                candidates &= candidates - 1;
+                if ((overlapping >> lane) & 1u || touching_intervals_overlap(first, i, second, j + lane)) {
+                    pairs.emplace_back(static_cast<std::uint32_t>(i), static_cast<std::uint32_t>(j + lane));
+                }
+            }
+        }
+
+        for (; j < size; ++j) {
+            if (simple_intervals_overlap(first, i, second, j)) {
+                pairs.emplace_back(static_cast<std::uint32_t>(i), static_cast<std::uint32_t>(j));
+            }
+        }
+    }
+}
+#else
+void overlapping_pairs_avx2(const SimpleIntervalColumns &first, const SimpleIntervalColumns &second,
+                            std::vector<IndexPair> &pairs, bool only_upper_triangle) {
+    overlapping_pairs_scalar(first, second, pairs, only_upper_triangle);
+}
+#endif
+
+void overlapping_pairs(const SimpleIntervalColumns &first, const SimpleIntervalColumns &second,
+                       std::vector<IndexPair> &pairs) {
+    if (avx2_available()) {
+        overlapping_pairs_avx2(first, second, pairs);
+    } else {
+        overlapping_pairs_scalar(first, second, pairs);
+    }
+}
+
+void overlapping_pairs_within(const SimpleIntervalColumns &columns, std::vector<IndexPair> &pairs) {
+    if (avx2_available()) {
+        overlapping_pairs_avx2(columns, columns, pairs, true);
+    } else {
+        overlapping_pairs_scalar(columns, columns, pairs, true);
+    }
+}
+
+void intersect_columns(const SimpleIntervalColumns &first, const SimpleIntervalColumns &second,
+                       SimpleIntervalColumns &result) {
+    std::vector<IndexPair> pairs;
+    overlapping_pairs(first, second, pairs);
+    result.reserve(result.size() + pairs.size());
+
+    for (const auto &[i, j]: pairs) {
+        result.lower.push_back(std::max(first.lower[i], second.lower[j]));
+        result.upper.push_back(std::min(first.upper[i], second.upper[j]));
+
+        std::uint8_t left;
+        if (first.lower[i] == second.lower[j]) {
+            left = first.borders[i] & second.borders[j] & SimpleIntervalColumns::LEFT_CLOSED;
+        } else {
+            left = (first.lower[i] > second.lower[j] ? first.borders[i] : second.borders[j]) &
+                   SimpleIntervalColumns::LEFT_CLOSED;
+        }
+
+        std::uint8_t right;
+        if (first.upper[i] == second.upper[j]) {
+            right = first.borders[i] & second.borders[j] & SimpleIntervalColumns::RIGHT_CLOSED;
+        } else {
+            right = (first.upper[i] < second.upper[j] ? first.borders[i] : second.borders[j]) &
+                    SimpleIntervalColumns::RIGHT_CLOSED;
+        }
+        result.borders.push_back(static_cast<std::uint8_t>(left | right));
+    }
+}
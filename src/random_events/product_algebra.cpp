@@ -1,25 +1,292 @@
 #include "product_algebra.h"
+#include <algorithm>
+#include <future>
+#include <limits>
+#include <numeric>
+#include <optional>
+#include <stdexcept>
+#include <thread>
 #include "variable.h"
 
+namespace {
+
+    /**
+     * @return True if an operation that starts now is recorded, such that boxes have to be wrapped into events for
+     * the trace.
+     */
+    bool records_next_operation() {
+        return operation_trace_depth == 0 && operation_tracing_enabled.load(std::memory_order_relaxed);
+    }
+}
+
+SetType full_domain_of(const VisitVariableVariant &variable) {
+    const auto &variable_variant = variable.variable_variant;
+    if (std::holds_alternative<Continuous>(variable_variant) || std::holds_alternative<Integer>(variable_variant)) {
+        return reals();
+    }
+    if (std::holds_alternative<Symbolic>(variable_variant)) {
+        const auto &all_elements = std::get<Symbolic>(variable_variant).domain.all_elements;
+        SimpleSetType<SimpleSet> elements;
+        for (const auto &element: all_elements) {
+            elements.insert(SimpleSet(element, all_elements));
+        }
+        return Set(elements, all_elements);
+    }
+    return std::monostate{};
+}
+
+MemoryFootprint set_type_memory_footprint(const SetType &set) {
+    if (std::holds_alternative<Interval>(set)) {
+        return std::get<Interval>(set).memory_footprint();
+    }
+    if (std::holds_alternative<Set>(set)) {
+        return std::get<Set>(set).memory_footprint();
+    }
+    return {};
+}
+
+MemoryFootprint variable_memory_footprint(const VisitVariableVariant &variable) {
+    MemoryFootprint result;
+    const auto &variable_variant = variable.variable_variant;
+    if (std::holds_alternative<Continuous>(variable_variant)) {
+        const auto &continuous = std::get<Continuous>(variable_variant);
+        result.strings += string_heap_bytes(continuous.name);
+        result += continuous.domain.memory_footprint().as_domain();
+        result += continuous.Variable<Continuous, Interval>::domain.memory_footprint().as_domain();
+    } else if (std::holds_alternative<Integer>(variable_variant)) {
+        const auto &integer = std::get<Integer>(variable_variant);
+        result.strings += string_heap_bytes(integer.name);
+        result += integer.domain.memory_footprint().as_domain();
+        result += integer.Variable<Integer, Interval>::domain.memory_footprint().as_domain();
+    } else if (std::holds_alternative<Symbolic>(variable_variant)) {
+        const auto &symbolic = std::get<Symbolic>(variable_variant);
+        result.strings += string_heap_bytes(symbolic.name);
+        result += symbolic.domain.memory_footprint().as_domain();
+    }
+    return result;
+}
+
 SimpleEvent SimpleEvent::simple_set_intersection_with(const SimpleEvent &other) const {
     auto result = SimpleEvent();
-//
-//    auto all_variables = merge_keys_of_assignments(other.variable_assignments);
-//
-//    for (const auto& variable : all_variables){
-//        auto assignment;
-//
-//        auto this_assignment = variable_assignments.find(variable);
-//
-//        if this_assignment is not Null:
-//            default_assignment = default_assignment.intersection(this_assignment);
-//
-//        auto other_assignment = other.variable_assignments.find(variable);
-//        if other_assignment is not Null:
-//            default_assignment = default_assignment.intersection(other_assignment);
-//
-//        result.variable_assignments.insert({variable, default_assignment});
-//    }
+
+    // walk both assignments in the order of their variables, such that only constrained variables are visited
+    auto this_assignment = variable_assignments.begin();
+    auto other_assignment = other.variable_assignments.begin();
+    while (this_assignment != variable_assignments.end() || other_assignment != other.variable_assignments.end()) {
+
+        // variables that are only assigned in one of both are not constrained by the other
+        if (other_assignment == other.variable_assignments.end() ||
+            (this_assignment != variable_assignments.end() && this_assignment->first < other_assignment->first)) {
+            result.variable_assignments.insert(result.variable_assignments.end(), *this_assignment++);
+            continue;
+        }
+        if (this_assignment == variable_assignments.end() || other_assignment->first < this_assignment->first) {
+            result.variable_assignments.insert(result.variable_assignments.end(), *other_assignment++);
+            continue;
+        }
+
+        auto assignment = intersect_set_variants(this_assignment->second, other_assignment->second);
+
+        // if any dimension is empty, the entire intersection is empty
+        if (set_variant_is_empty(assignment)) {
+            return SimpleEvent();
+        }
+
+        result.variable_assignments.insert(result.variable_assignments.end(), {this_assignment->first, assignment});
+        ++this_assignment;
+        ++other_assignment;
+    }
+    return result;
+}
+
+Event SimpleEvent::simple_set_complement() const {
+    Event result;
+
+    // the assignments of the variables before the current one
+    VariableAssignmentType prefix;
+
+    for (const auto &[variable, assignment]: variable_assignments) {
+
+        // the complement of the current dimension within the domain of the variable
+        auto complement = complement_of_set_variant(assignment);
+
+        // the variables after the current one are unconstrained and therefore not assigned
+        if (!set_variant_is_empty(complement)) {
+            SimpleEvent box(prefix);
+            box.variable_assignments.insert({variable, complement});
+            result.simple_sets.insert(box);
+        }
+
+        prefix.insert(prefix.end(), {variable, assignment});
+    }
+    return result;
+}
+
+Event SimpleEvent::difference_with(const SimpleEvent &other) const {
+    std::optional<Event> traced_first;
+    std::optional<Event> traced_second;
+    std::optional<OperationTimer<Event>> timer;
+    if (records_next_operation()) {
+        traced_first.emplace(*this);
+        traced_second.emplace(other);
+        timer.emplace(TracedOperation::DIFFERENCE, *traced_first, &*traced_second);
+    }
+
+    // if both do not intersect, nothing has to be removed
+    auto intersection = intersection_with(other);
+    if (intersection.is_empty()) {
+        return Event(*this);
+    }
+
+    Event result;
+
+    // the assignments of the variables before the current one
+    VariableAssignmentType prefix;
+
+    for (const auto &[variable, intersection_assignment]: intersection.variable_assignments) {
+
+        // the difference of the current dimension, where variables that are not assigned in this take their entire
+        // domain and the difference is the complement of the intersection
+        auto this_assignment = variable_assignments.find(variable);
+        auto difference = this_assignment == variable_assignments.end() ?
+                          complement_of_set_variant(intersection_assignment) :
+                          difference_of_set_variants(this_assignment->second, intersection_assignment);
+
+        if (!set_variant_is_empty(difference)) {
+            SimpleEvent box(prefix);
+            box.variable_assignments.insert({variable, difference});
+
+            // the variables after the current one keep the assignments of this
+            for (auto remaining = variable_assignments.upper_bound(variable);
+                 remaining != variable_assignments.end(); ++remaining) {
+                box.variable_assignments.insert(box.variable_assignments.end(), *remaining);
+            }
+            result.simple_sets.insert(box);
+        }
+
+        prefix.insert(prefix.end(), {variable, intersection_assignment});
+    }
+    return result;
+}
+
+bool SimpleEvent::is_subset_of(const SimpleEvent &other) const {
+    if (is_empty()) {
+        return true;
+    }
+    if (other.is_empty()) {
+        return false;
+    }
+
+    // only the variables that the other constrains can exclude points of this
+    for (const auto &[variable, other_assignment]: other.variable_assignments) {
+        auto this_assignment = variable_assignments.find(variable);
+        auto excluded = this_assignment == variable_assignments.end() ?
+                        complement_of_set_variant(other_assignment) :
+                        difference_of_set_variants(this_assignment->second, other_assignment);
+        if (!set_variant_is_empty(excluded)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool SimpleEvent::simple_set_is_empty() const {
+    if (variable_assignments.empty()) {
+        return true;
+    }
+    for (const auto &[variable, assignment]: variable_assignments) {
+        if (set_variant_is_empty(assignment)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+MemoryFootprint SimpleEvent::simple_set_memory_footprint() const {
+    MemoryFootprint result;
+    for (const auto &[variable, assignment]: variable_assignments) {
+        result.container_nodes += tree_node_bytes<VariableAssignmentType::value_type>();
+        result += variable_memory_footprint(variable);
+        result += set_type_memory_footprint(assignment);
+    }
+    return result;
+}
+
+double SimpleEvent::measure() const {
+    if (simple_set_is_empty()) {
+        return 0;
+    }
+    double result = 1;
+    for (const auto &[variable, assignment]: variable_assignments) {
+        double assignment_measure = 1;
+        if (std::holds_alternative<Interval>(assignment)) {
+            assignment_measure = std::get<Interval>(assignment).measure();
+        } else if (std::holds_alternative<Set>(assignment)) {
+            assignment_measure = static_cast<double>(std::get<Set>(assignment).simple_sets.size());
+        }
+
+        // a null dimension makes the box a null set, also if other dimensions are unbounded
+        if (assignment_measure == 0) {
+            return 0;
+        }
+        result *= assignment_measure;
+    }
+    return result;
+}
+
+double SimpleEvent::measure(const std::set<VisitVariableVariant> &variables) const {
+    auto result = measure();
+    if (result == 0) {
+        return 0;
+    }
+    for (const auto &variable: variables) {
+        if (variable_assignments.find(variable) != variable_assignments.end()) {
+            continue;
+        }
+        const auto &variable_variant = variable.variable_variant;
+        double domain_measure = 1;
+        if (std::holds_alternative<Continuous>(variable_variant) || std::holds_alternative<Integer>(variable_variant)) {
+            domain_measure = std::numeric_limits<double>::infinity();
+        } else if (std::holds_alternative<Symbolic>(variable_variant)) {
+            domain_measure = static_cast<double>(std::get<Symbolic>(variable_variant).domain.all_elements.size());
+        }
+
+        // an empty domain empties the space, also if other dimensions are unbounded
+        if (domain_measure == 0) {
+            return 0;
+        }
+        result *= domain_measure;
+    }
+    return result;
+}
+
+bool SimpleEvent::operator==(const SimpleEvent &other) const {
+    return variable_assignments == other.variable_assignments;
+}
+
+std::string SimpleEvent::to_string() const {
+    if (is_empty()) {
+        return "∅";
+    }
+    std::string result = "{";
+    bool first_iteration = true;
+    for (const auto &[variable, assignment]: variable_assignments) {
+        if (!first_iteration) {
+            result.append(", ");
+        }
+        first_iteration = false;
+        result.append(std::visit([](const auto &variable_) -> std::string {
+            if constexpr (std::is_same_v<std::decay_t<decltype(variable_)>, std::monostate>) {
+                return "";
+            } else {
+                return variable_.name;
+            }
+        }, variable.variable_variant));
+        result.append(": ");
+        result.append(set_variant_to_string(assignment));
+    }
+    result.append("}");
+    return result;
 }
 
 std::set<VisitVariableVariant> SimpleEvent::merge_keys_of_assignments(const VariableAssignmentType &other_assignments) const {
@@ -36,15 +303,715 @@ std::set<VisitVariableVariant> SimpleEvent::merge_keys_of_assignments(const Vari
     return all_variables;
 }
 
-SimpleEvent::SimpleEvent(VariableAssignmentType &variableAssignmentType) {
+SimpleEvent::SimpleEvent(const VariableAssignmentType &variableAssignmentType) {
     variable_assignments = variableAssignmentType;
 
 }
 
-SimpleEvent::SimpleEvent(std::map<VariableVariant, SetType> &assignment) {
+SimpleEvent::SimpleEvent(const std::map<VariableVariant, SetType> &assignment) {
     for (const auto& pair : assignment){
         variable_assignments.insert(pair);
     }
 }
 
+std::tuple<Event, bool> Event::merge_boxes_along(const VisitVariableVariant &variable) const {
+    Event result;
+
+    // the assignments of the other variables mapped to the united assignments of the variable
+    std::unordered_map<VariableAssignmentType, SetType> groups;
+    bool merged = false;
+
+    for (const auto &simple_event: simple_sets) {
+        auto assignment = simple_event.variable_assignments.find(variable);
+
+        // boxes that do not constrain the variable cannot be merged along it
+        if (assignment == simple_event.variable_assignments.end()) {
+            result.simple_sets.insert(simple_event);
+            continue;
+        }
+
+        auto other_assignments = simple_event.variable_assignments;
+        other_assignments.erase(variable);
+
+        auto [group, inserted] = groups.try_emplace(other_assignments, assignment->second);
+        if (!inserted) {
+            group->second = union_of_set_variants(group->second, assignment->second);
+            merged = true;
+        }
+    }
+
+    for (auto &[other_assignments, assignment]: groups) {
+        SimpleEvent simple_event(other_assignments);
+        simple_event.variable_assignments.insert({variable, assignment});
+        result.simple_sets.insert(simple_event);
+    }
+    return {result, merged};
+}
+
+Event Event::composite_set_simplify() {
+    Event result = *this;
+
+    // merge along every variable until a fixpoint is reached
+    bool merged = true;
+    while (merged && result.simple_sets.size() > 1) {
+        merged = false;
+
+        std::set<VisitVariableVariant> all_variables;
+        for (const auto &simple_event: result.simple_sets) {
+            for (const auto &[variable, assignment]: simple_event.variable_assignments) {
+                all_variables.insert(variable);
+            }
+        }
+
+        for (const auto &variable: all_variables) {
+            bool merged_along_variable;
+            std::tie(result, merged_along_variable) = result.merge_boxes_along(variable);
+            merged = merged || merged_along_variable;
+        }
+    }
+    return result;
+}
+
+std::set<VisitVariableVariant> Event::variables() const {
+    std::set<VisitVariableVariant> result;
+    for (const auto &simple_event: simple_sets) {
+        for (const auto &[variable, assignment]: simple_event.variable_assignments) {
+            result.insert(variable);
+        }
+    }
+    return result;
+}
+
+double Event::measure(const std::set<VisitVariableVariant> &variables) const {
+    double result = 0;
+    for (const auto &simple_event: simple_sets) {
+        result += simple_event.measure(variables);
+    }
+    return result;
+}
+
+std::tuple<Event, double> Event::coarsen(std::size_t max_pieces, float epsilon) const {
+    Event result;
+    Event grown_boxes;
+
+    for (const auto &simple_event: simple_sets) {
+        SimpleEvent coarsened = simple_event;
+        bool box_grown = false;
+        for (auto &[variable, assignment]: coarsened.variable_assignments) {
+            if (!std::holds_alternative<Interval>(assignment)) {
+                continue;
+            }
+            auto coarsened_interval = std::get<0>(std::get<Interval>(assignment).coarsen(max_pieces, epsilon));
+            if (coarsened_interval.simple_sets.size() != std::get<Interval>(assignment).simple_sets.size()) {
+                assignment = coarsened_interval;
+                box_grown = true;
+            }
+        }
+        if (box_grown) {
+            grown_boxes.simple_sets.insert(coarsened);
+        }
+        result.simple_sets.insert(coarsened);
+    }
+    if (grown_boxes.is_empty()) {
+        return {result, 0};
+    }
+
+    // grown boxes may overlap with their neighbours
+    result = result.make_disjoint();
+
+    // the error is the measure of what the grown boxes added to this, such that areas covered by several grown boxes
+    // count once and closed gaps are weighted with the extent of the other dimensions of their box
+    auto added = grown_boxes.make_disjoint().difference_with(*this);
+    return {result, added.measure(variables())};
+}
+
+Event Event::complement() const {
+    return std::get<0>(complement(OperationBudget()));
+}
+
+std::tuple<Event, OperationStatus> Event::complement(const OperationBudget &budget) const {
+    OperationTimer<Event> timer(TracedOperation::COMPLEMENT, *this);
+    if (is_empty()) {
+        return {Event(), OperationStatus::OK};
+    }
+
+    // start with the complement of the first box
+    auto current = simple_sets.begin();
+    Event result = current->complement();
+
+    // remove every other box from the complement one box of the complement at a time, such that a single removal
+    // cannot exceed the budget unnoticed
+    for (++current; current != simple_sets.end(); ++current) {
+        Event remainder;
+        for (const auto &simple_event: result.simple_sets) {
+            auto difference = simple_event.difference_with(*current);
+            remainder.simple_sets.insert(difference.simple_sets.begin(), difference.simple_sets.end());
+
+            auto status = budget.check(remainder.simple_sets.size());
+            if (status != OperationStatus::OK) {
+                return {Event(), status};
+            }
+        }
+        result = std::move(remainder);
+    }
+
+    auto status = budget.check(result.simple_sets.size());
+    if (status != OperationStatus::OK) {
+        return {Event(), status};
+    }
+    return {result.simplify(), OperationStatus::OK};
+}
+
+Event Event::difference_with(const SimpleEvent &other) const {
+    std::optional<Event> traced_other;
+    if (records_next_operation()) {
+        traced_other.emplace(other);
+    }
+    OperationTimer<Event> timer(TracedOperation::DIFFERENCE, *this, traced_other ? &*traced_other : nullptr);
+    Event result;
+    for (const auto &simple_event: simple_sets) {
+        auto difference = simple_event.difference_with(other);
+        result.simple_sets.insert(difference.simple_sets.begin(), difference.simple_sets.end());
+    }
+    return result;
+}
+
+Event Event::difference_with(const Event &other) const {
+    return std::get<0>(difference_with(other, OperationBudget()));
+}
+
+std::tuple<Event, OperationStatus> Event::difference_with(const Event &other, const OperationBudget &budget) const {
+    OperationTimer<Event> timer(TracedOperation::DIFFERENCE, *this, &other);
+    Event result;
+    if (bounding_hulls_disjoint(other)) {
+        result = *this;
+        return {result.simplify(), OperationStatus::OK};
+    }
+    for (const auto &simple_event: simple_sets) {
+        Event current_difference(simple_event);
+        for (const auto &other_simple_event: other.simple_sets) {
+            current_difference = current_difference.difference_with(other_simple_event);
+            if (current_difference.is_empty()) {
+                break;
+            }
+
+            auto status = budget.check(result.simple_sets.size() + current_difference.simple_sets.size());
+            if (status != OperationStatus::OK) {
+                return {Event(), status};
+            }
+        }
+        result.simple_sets.insert(current_difference.simple_sets.begin(), current_difference.simple_sets.end());
+    }
+
+    auto status = budget.check(result.simple_sets.size());
+    if (status != OperationStatus::OK) {
+        return {Event(), status};
+    }
+    return {result.simplify(), OperationStatus::OK};
+}
+
+namespace {
+
+    /**
+     * Disjoint boxes over a subset of variables in a canonical order.
+     */
+    using ProjectedBoxes = std::set<VariableAssignmentType>;
+
+    ProjectedBoxes disjoint_union_of_boxes(const std::vector<VariableAssignmentType> &boxes,
+                                           const std::vector<std::size_t> &active,
+                                           const std::vector<VisitVariableVariant> &variables,
+                                           std::size_t dimension);
+
+    /**
+     * @return The remainder of the active boxes on the dimensions after the given one.
+     */
+    ProjectedBoxes remainder_of_boxes(const std::vector<VariableAssignmentType> &boxes,
+                                      const std::vector<std::size_t> &active,
+                                      const std::vector<VisitVariableVariant> &variables,
+                                      std::size_t dimension) {
+        if (dimension + 1 == variables.size()) {
+            return active.empty() ? ProjectedBoxes() : ProjectedBoxes{VariableAssignmentType()};
+        }
+        return disjoint_union_of_boxes(boxes, active, variables, dimension + 1);
+    }
+
+    /**
+     * Sweep the active boxes along an interval dimension.
+     *
+     * The distinct bounds v_0 < ... < v_k cut the real line into elementary segments, where segment 2i + 1 is the
+     * point v_i and segment 2i is the open gap before it. Every simple interval is a range of segments, such that the
+     * set of boxes covering a segment only changes at the bounds of these ranges.
+     *
+     * @return The remainders of the dimensions after this one mapped to the slabs that have them.
+     */
+    std::map<ProjectedBoxes, Interval> sweep_interval_dimension(const std::vector<VariableAssignmentType> &boxes,
+                                                                 const std::vector<std::size_t> &active,
+                                                                 const std::vector<VisitVariableVariant> &variables,
+                                                                 std::size_t dimension) {
+        const auto &variable = variables[dimension];
+
+        std::vector<float> bounds;
+        for (auto box: active) {
+            for (const auto &simple_interval: std::get<Interval>(boxes[box].at(variable)).simple_sets) {
+                bounds.push_back(simple_interval.lower);
+                bounds.push_back(simple_interval.upper);
+            }
+        }
+        std::sort(bounds.begin(), bounds.end());
+        bounds.erase(std::unique(bounds.begin(), bounds.end()), bounds.end());
+
+        auto position_of = [&bounds](float value) {
+            return static_cast<std::size_t>(std::lower_bound(bounds.begin(), bounds.end(), value) - bounds.begin());
+        };
+
+        // the segments at which a box starts or stops to cover
+        std::vector<std::tuple<std::size_t, bool, std::size_t>> changes;
+        for (auto box: active) {
+            for (const auto &simple_interval: std::get<Interval>(boxes[box].at(variable)).simple_sets) {
+                if (simple_interval.is_empty()) {
+                    continue;
+                }
+                auto lower = position_of(simple_interval.lower);
+                auto upper = position_of(simple_interval.upper);
+                auto first = simple_interval.left == BorderType::CLOSED ? 2 * lower + 1 : 2 * lower + 2;
+                auto last = simple_interval.right == BorderType::CLOSED ? 2 * upper + 1 : 2 * upper;
+                changes.emplace_back(first, true, box);
+                changes.emplace_back(last + 1, false, box);
+            }
+        }
+        std::sort(changes.begin(), changes.end());
+
+        // the segment ranges of every remainder, where adjacent ranges are merged
+        std::map<ProjectedBoxes, std::vector<std::pair<std::size_t, std::size_t>>> ranges;
+        std::set<std::size_t> covering;
+        for (std::size_t i = 0; i < changes.size();) {
+            auto segment = std::get<0>(changes[i]);
+            for (; i < changes.size() && std::get<0>(changes[i]) == segment; ++i) {
+                if (std::get<1>(changes[i])) {
+                    covering.insert(std::get<2>(changes[i]));
+                } else {
+                    covering.erase(std::get<2>(changes[i]));
+                }
+            }
+            if (covering.empty() || i == changes.size()) {
+                continue;
+            }
+
+            auto remainder = remainder_of_boxes(boxes, std::vector<std::size_t>(covering.begin(), covering.end()),
+                                                variables, dimension);
+            auto &remainder_ranges = ranges[remainder];
+            auto last = std::get<0>(changes[i]) - 1;
+            if (!remainder_ranges.empty() && remainder_ranges.back().second + 1 == segment) {
+                remainder_ranges.back().second = last;
+            } else {
+                remainder_ranges.emplace_back(segment, last);
+            }
+        }
+
+        std::map<ProjectedBoxes, Interval> result;
+        for (const auto &[remainder, segment_ranges]: ranges) {
+            SimpleSetType<SimpleInterval> slabs;
+            for (const auto &[first, last]: segment_ranges) {
+                auto lower = first % 2 == 1 ? bounds[first / 2] : bounds[first / 2 - 1];
+                auto upper = bounds[last / 2];
+                slabs.insert(SimpleInterval(lower, upper, first % 2 == 1 ? BorderType::CLOSED : BorderType::OPEN,
+                                            last % 2 == 1 ? BorderType::CLOSED : BorderType::OPEN));
+            }
+            result.emplace(remainder, Interval(slabs));
+        }
+        return result;
+    }
+
+    /**
+     * Sweep the active boxes along a symbolic dimension by grouping the elements with the same covering boxes.
+     *
+     * @return The remainders of the dimensions after this one mapped to the elements that have them.
+     */
+    std::map<ProjectedBoxes, Set> sweep_set_dimension(const std::vector<VariableAssignmentType> &boxes,
+                                                      const std::vector<std::size_t> &active,
+                                                      const std::vector<VisitVariableVariant> &variables,
+                                                      std::size_t dimension) {
+        const auto &variable = variables[dimension];
+        const auto all_elements = std::get<Set>(boxes[active.front()].at(variable)).all_elements;
+
+        std::map<std::string, std::vector<std::size_t>> covering;
+        for (auto box: active) {
+            for (const auto &simple_set: std::get<Set>(boxes[box].at(variable)).simple_sets) {
+                covering[simple_set.element].push_back(box);
+            }
+        }
+
+        std::map<std::vector<std::size_t>, std::vector<std::string>> elements_by_covering;
+        for (const auto &[element, covering_boxes]: covering) {
+            elements_by_covering[covering_boxes].push_back(element);
+        }
+
+        std::map<ProjectedBoxes, SimpleSetType<SimpleSet>> elements_by_remainder;
+        for (const auto &[covering_boxes, elements]: elements_by_covering) {
+            auto &remainder_elements = elements_by_remainder[remainder_of_boxes(boxes, covering_boxes, variables,
+                                                                                dimension)];
+            for (const auto &element: elements) {
+                remainder_elements.insert(SimpleSet(element, all_elements));
+            }
+        }
+
+        std::map<ProjectedBoxes, Set> result;
+        for (const auto &[remainder, elements]: elements_by_remainder) {
+            result.emplace(remainder, Set(elements, all_elements));
+        }
+        return result;
+    }
+
+    /**
+     * Form the union of the active boxes on the dimensions from the given one onwards as disjoint boxes.
+     */
+    ProjectedBoxes disjoint_union_of_boxes(const std::vector<VariableAssignmentType> &boxes,
+                                           const std::vector<std::size_t> &active,
+                                           const std::vector<VisitVariableVariant> &variables,
+                                           std::size_t dimension) {
+        ProjectedBoxes result;
+        if (active.empty()) {
+            return result;
+        }
+
+        const auto &variable = variables[dimension];
+        auto extend = [&result, &variable](const ProjectedBoxes &remainder, const SetType &slab) {
+            for (auto box: remainder) {
+                box.insert({variable, slab});
+                result.insert(std::move(box));
+            }
+        };
+
+        const auto &assignment = boxes[active.front()].at(variable);
+        if (std::holds_alternative<Interval>(assignment)) {
+            for (const auto &[remainder, slab]: sweep_interval_dimension(boxes, active, variables, dimension)) {
+                extend(remainder, slab);
+            }
+        } else if (std::holds_alternative<Set>(assignment)) {
+            for (const auto &[remainder, slab]: sweep_set_dimension(boxes, active, variables, dimension)) {
+                extend(remainder, slab);
+            }
+        } else {
+            throw std::invalid_argument("Cannot project onto an unassigned variable.");
+        }
+        return result;
+    }
+}
+
+Event Event::project(const std::set<VisitVariableVariant> &variables) const {
+    if (variables.empty()) {
+        return {};
+    }
+
+    // restrict every box to the variables and drop duplicates
+    std::set<VariableAssignmentType> projected;
+    for (const auto &simple_event: simple_sets) {
+        VariableAssignmentType box;
+        for (const auto &variable: variables) {
+            auto assignment = simple_event.variable_assignments.find(variable);
+            box.insert({variable, assignment == simple_event.variable_assignments.end() ? full_domain_of(variable)
+                                                                                       : assignment->second});
+        }
+        projected.insert(std::move(box));
+    }
+
+    std::vector<VariableAssignmentType> boxes(projected.begin(), projected.end());
+    std::vector<std::size_t> active(boxes.size());
+    std::iota(active.begin(), active.end(), 0);
+
+    Event result;
+    for (const auto &box: disjoint_union_of_boxes(boxes, active, {variables.begin(), variables.end()}, 0)) {
+        result.simple_sets.insert(SimpleEvent(box));
+    }
+    return result;
+}
 
+namespace {
+
+    Event as_disjoint(const Event &event) {
+        return event.is_disjoint() ? event : event.make_disjoint();
+    }
+
+    /**
+     * Unite two disjoint events by adding the boxes of the second event without the first one.
+     * The result is disjoint but not simplified.
+     */
+    Event unite_disjoint(const Event &first, const Event &second) {
+        Event result = first;
+        for (const auto &simple_event: second.simple_sets) {
+            Event remainder(simple_event);
+            for (const auto &other_simple_event: first.simple_sets) {
+                remainder = remainder.difference_with(other_simple_event);
+                if (remainder.is_empty()) {
+                    break;
+                }
+            }
+            result.simple_sets.insert(remainder.simple_sets.begin(), remainder.simple_sets.end());
+        }
+        return result;
+    }
+
+    /**
+     * Intersect two disjoint events box by box. The result is disjoint but not simplified.
+     */
+    Event intersect_disjoint(const Event &first, const Event &second) {
+        Event result;
+        for (const auto &simple_event: first.simple_sets) {
+            for (const auto &other_simple_event: second.simple_sets) {
+                auto intersection = simple_event.intersection_with(other_simple_event);
+                if (!intersection.is_empty()) {
+                    result.simple_sets.insert(intersection);
+                }
+            }
+        }
+        return result;
+    }
+
+    /**
+     * Reduce the events in [begin, end) by combining the reductions of both halves.
+     *
+     * @param parallel_depth The number of levels below this one in which the left half is reduced on another thread.
+     */
+    template<typename Combine>
+    Event reduce_events(const std::vector<Event> &events, std::size_t begin, std::size_t end,
+                        unsigned parallel_depth, const Combine &combine) {
+        if (end - begin == 1) {
+            return as_disjoint(events[begin]);
+        }
+        auto middle = begin + (end - begin) / 2;
+        if (parallel_depth > 0) {
+            auto left = std::async(std::launch::async, [&events, begin, middle, parallel_depth, &combine]() {
+                return reduce_events(events, begin, middle, parallel_depth - 1, combine);
+            });
+            auto right = reduce_events(events, middle, end, parallel_depth - 1, combine);
+            return combine(left.get(), right);
+        }
+        return combine(reduce_events(events, begin, middle, 0, combine),
+                       reduce_events(events, middle, end, 0, combine));
+    }
+
+    /**
+     * @return The number of levels of a reduction that are run in parallel to occupy the hardware threads.
+     */
+    unsigned parallel_depth(bool parallel) {
+        if (!parallel) {
+            return 0;
+        }
+        unsigned depth = 0;
+        for (auto threads = std::thread::hardware_concurrency(); threads > 1; threads /= 2) {
+            ++depth;
+        }
+        return depth;
+    }
+}
+
+Event union_all(const std::vector<Event> &events, bool parallel) {
+    if (events.empty()) {
+        return {};
+    }
+    return reduce_events(events, 0, events.size(), parallel_depth(parallel), unite_disjoint).simplify();
+}
+
+Event intersection_all(const std::vector<Event> &events, bool parallel) {
+    if (events.empty()) {
+        throw std::invalid_argument("The intersection of no events is undefined, since their variables are unknown.");
+    }
+    return reduce_events(events, 0, events.size(), parallel_depth(parallel), intersect_disjoint).simplify();
+}
+
+namespace {
+
+    /**
+     * @return The smallest simple interval that contains both simple intervals.
+     */
+    SimpleInterval hull_of(const SimpleInterval &first, const SimpleInterval &second) {
+        if (first.is_empty()) {
+            return second;
+        }
+        if (second.is_empty()) {
+            return first;
+        }
+        SimpleInterval result = first;
+        if (second.lower < result.lower || (second.lower == result.lower && second.left == BorderType::CLOSED)) {
+            result.lower = second.lower;
+            result.left = second.left;
+        }
+        if (second.upper > result.upper || (second.upper == result.upper && second.right == BorderType::CLOSED)) {
+            result.upper = second.upper;
+            result.right = second.right;
+        }
+        return result;
+    }
+
+    /**
+     * Set the bits of the elements of a set in a mask, where the bits are ordered like the elements of the domain.
+     */
+    void add_to_mask(const Set &set, std::vector<std::uint64_t> &mask) {
+        mask.resize((set.all_elements.size() + 63) / 64, 0);
+
+        // both the domain and the simple sets are ordered by their elements
+        std::size_t position = 0;
+        auto element = set.all_elements.begin();
+        for (const auto &simple_set: set.simple_sets) {
+            while (element != set.all_elements.end() && *element < simple_set.element) {
+                ++element;
+                ++position;
+            }
+            if (element != set.all_elements.end() && *element == simple_set.element) {
+                mask[position / 64] |= std::uint64_t{1} << (position % 64);
+            }
+        }
+    }
+
+    /**
+     * @return True if the mask has the bits of all elements of a domain with the given size set.
+     */
+    bool is_full_mask(const std::vector<std::uint64_t> &mask, std::size_t size) {
+        for (std::size_t word = 0; word < mask.size(); ++word) {
+            auto bits = std::min<std::size_t>(64, size - 64 * word);
+            auto expected = bits == 64 ? ~std::uint64_t{0} : (std::uint64_t{1} << bits) - 1;
+            if (mask[word] != expected) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    EventHull event_hull_of(const SimpleSetType<SimpleEvent> &simple_events) {
+        EventHull result;
+        if (simple_events.empty()) {
+            return result;
+        }
+        result.empty = false;
+
+        // the size of the domain of every symbolic variable
+        std::map<VisitVariableVariant, std::size_t> domain_sizes;
+
+        // start with the assignments of the first box and widen them by the following boxes
+        bool first_box = true;
+        for (const auto &simple_event: simple_events) {
+            const auto &assignments = simple_event.variable_assignments;
+            if (first_box) {
+                first_box = false;
+                for (const auto &[variable, assignment]: assignments) {
+                    if (std::holds_alternative<Interval>(assignment)) {
+                        result.intervals.insert({variable, std::get<Interval>(assignment).bounding_hull()});
+                    } else if (std::holds_alternative<Set>(assignment)) {
+                        const auto &set = std::get<Set>(assignment);
+                        add_to_mask(set, result.symbols[variable]);
+                        domain_sizes[variable] = set.all_elements.size();
+                    }
+                }
+                continue;
+            }
+
+            for (auto interval = result.intervals.begin(); interval != result.intervals.end();) {
+                auto assignment = assignments.find(interval->first);
+                if (assignment == assignments.end() || !std::holds_alternative<Interval>(assignment->second)) {
+                    interval = result.intervals.erase(interval);
+                    continue;
+                }
+                interval->second = hull_of(interval->second, std::get<Interval>(assignment->second).bounding_hull());
+                ++interval;
+            }
+
+            for (auto symbols = result.symbols.begin(); symbols != result.symbols.end();) {
+                auto assignment = assignments.find(symbols->first);
+                if (assignment == assignments.end() || !std::holds_alternative<Set>(assignment->second) ||
+                    std::get<Set>(assignment->second).all_elements.size() != domain_sizes[symbols->first]) {
+                    symbols = result.symbols.erase(symbols);
+                    continue;
+                }
+                add_to_mask(std::get<Set>(assignment->second), symbols->second);
+                ++symbols;
+            }
+        }
+
+        // bounds that cover the entire domain do not bound anything
+        for (auto interval = result.intervals.begin(); interval != result.intervals.end();) {
+            if (interval->second.lower == -std::numeric_limits<float>::infinity() &&
+                interval->second.upper == std::numeric_limits<float>::infinity()) {
+                interval = result.intervals.erase(interval);
+            } else {
+                ++interval;
+            }
+        }
+        for (auto symbols = result.symbols.begin(); symbols != result.symbols.end();) {
+            if (is_full_mask(symbols->second, domain_sizes[symbols->first])) {
+                symbols = result.symbols.erase(symbols);
+            } else {
+                ++symbols;
+            }
+        }
+        return result;
+    }
+}
+
+bool EventHull::is_disjoint_with(const EventHull &other) const {
+    if (empty || other.empty) {
+        return true;
+    }
+    for (const auto &[variable, interval]: intervals) {
+        auto other_interval = other.intervals.find(variable);
+        if (other_interval != other.intervals.end() &&
+            interval.intersection_with(other_interval->second).is_empty()) {
+            return true;
+        }
+    }
+    for (const auto &[variable, mask]: symbols) {
+        auto other_mask = other.symbols.find(variable);
+        if (other_mask == other.symbols.end() || other_mask->second.size() != mask.size()) {
+            continue;
+        }
+        bool common_element = false;
+        for (std::size_t word = 0; word < mask.size() && !common_element; ++word) {
+            common_element = (mask[word] & other_mask->second[word]) != 0;
+        }
+        if (!common_element) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool EventHull::contains(const EventHull &other) const {
+    if (other.empty) {
+        return true;
+    }
+    if (empty) {
+        return false;
+    }
+
+    // the other hull is unbounded in the variables it does not bound
+    for (const auto &[variable, interval]: intervals) {
+        auto other_interval = other.intervals.find(variable);
+        if (other_interval == other.intervals.end() ||
+            !(interval.intersection_with(other_interval->second) == other_interval->second)) {
+            return false;
+        }
+    }
+    for (const auto &[variable, mask]: symbols) {
+        auto other_mask = other.symbols.find(variable);
+        if (other_mask == other.symbols.end() || other_mask->second.size() != mask.size()) {
+            return false;
+        }
+        for (std::size_t word = 0; word < mask.size(); ++word) {
+            if ((other_mask->second[word] & ~mask[word]) != 0) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+const EventHull &Event::bounding_hull() const {
+    return simple_sets.bounding_hull(event_hull_of);
+}
+
+bool Event::bounding_hulls_disjoint(const Event &other) const {
+    return bounding_hull().is_disjoint_with(other.bounding_hull());
+}
+
+bool Event::bounding_hull_contains(const Event &other) const {
+    return bounding_hull().contains(other.bounding_hull());
+}
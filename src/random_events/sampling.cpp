@@ -0,0 +1,372 @@
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <tuple>
+#include "sampling.h"
+
+namespace {
+    std::uint64_t splitmix64(std::uint64_t &x) {
+        std::uint64_t z = (x += 0x9e3779b97f4a7c15ULL);
+        z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+        return z ^ (z >> 31);
+    }
+
+    std::uint64_t rotl(std::uint64_t x, int k) {
+        return (x << k) | (x >> (64 - k));
+    }
+
+    /**
+     * @return The smallest and largest integer within a simple interval.
+     */
+    std::pair<double, double> integer_bounds(const SimpleInterval &simple_interval) {
+        double first = std::ceil(simple_interval.lower);
+        if (first == simple_interval.lower && simple_interval.left == BorderType::OPEN) {
+            first += 1;
+        }
+        double last = std::floor(simple_interval.upper);
+        if (last == simple_interval.upper && simple_interval.right == BorderType::OPEN) {
+            last -= 1;
+        }
+        return {first, last};
+    }
+
+    /**
+     * @return The smallest and largest float within a simple interval.
+     */
+    std::pair<float, float> float_bounds(const SimpleInterval &simple_interval) {
+        float first = simple_interval.left == BorderType::OPEN ?
+                      std::nextafter(simple_interval.lower, std::numeric_limits<float>::infinity()) :
+                      simple_interval.lower;
+        float last = simple_interval.right == BorderType::OPEN ?
+                     std::nextafter(simple_interval.upper, -std::numeric_limits<float>::infinity()) :
+                     simple_interval.upper;
+        return {first, last};
+    }
+
+    /**
+     * @return True if a simple interval contains a float or, for integer samplers, an integer.
+     */
+    bool contains_values(const SimpleInterval &simple_interval, bool integer) {
+        if (integer) {
+            auto [first, last] = integer_bounds(simple_interval);
+            return first <= last;
+        }
+        auto [first, last] = float_bounds(simple_interval);
+        return first <= last;
+    }
+
+    /**
+     * Multiply two 64 bit numbers into their 128 bit product.
+     *
+     * @return The high and low 64 bits of the product.
+     */
+    std::pair<std::uint64_t, std::uint64_t> multiply_wide(std::uint64_t first, std::uint64_t second) {
+#ifdef __SIZEOF_INT128__
+        auto product = static_cast<unsigned __int128>(first) * second;
+        return {static_cast<std::uint64_t>(product >> 64), static_cast<std::uint64_t>(product)};
+#else
+        // schoolbook multiplication of the 32 bit halves
+        const std::uint64_t mask = 0xFFFFFFFFULL;
+        const std::uint64_t low_low = (first & mask) * (second & mask);
+        const std::uint64_t high_low = (first >> 32) * (second & mask);
+        const std::uint64_t low_high = (first & mask) * (second >> 32);
+        const std::uint64_t high_high = (first >> 32) * (second >> 32);
+        const std::uint64_t middle = (low_low >> 32) + (high_low & mask) + low_high;
+        return {high_high + (high_low >> 32) + (middle >> 32), (middle << 32) | (low_low & mask)};
+#endif
+    }
+}
+
+Xoshiro256::Xoshiro256(std::uint64_t seed) {
+    for (auto &word: state) {
+        word = splitmix64(seed);
+    }
+}
+
+Xoshiro256 Xoshiro256::for_thread(std::uint64_t seed, std::size_t thread_index) {
+    Xoshiro256 rng(seed);
+    for (std::size_t i = 0; i < thread_index; ++i) {
+        rng.jump();
+    }
+    return rng;
+}
+
+Xoshiro256::result_type Xoshiro256::operator()() {
+    const std::uint64_t result = rotl(state[0] + state[3], 23) + state[0];
+    const std::uint64_t t = state[1] << 17;
+    state[2] ^= state[0];
+    state[3] ^= state[1];
+    state[1] ^= state[2];
+    state[0] ^= state[3];
+    state[2] ^= t;
+    state[3] = rotl(state[3], 45);
+    return result;
+}
+
+float Xoshiro256::uniform_float() {
+    return static_cast<float>((*this)() >> 40) * 0x1.0p-24f;
+}
+
+double Xoshiro256::uniform_double() {
+    return static_cast<double>((*this)() >> 11) * 0x1.0p-53;
+}
+
+std::uint64_t Xoshiro256::uniform_below(std::uint64_t bound) {
+    // Lemire's nearly divisionless method
+    auto [high, low] = multiply_wide((*this)(), bound);
+    if (low < bound) {
+        const std::uint64_t threshold = -bound % bound;
+        while (low < threshold) {
+            std::tie(high, low) = multiply_wide((*this)(), bound);
+        }
+    }
+    return high;
+}
+
+void Xoshiro256::jump() {
+    static constexpr std::uint64_t jump_polynomial[] = {0x180ec6d33cfd0abaULL, 0xd5a61266f0c9392cULL,
+                                                        0xa9582618e03fc9aaULL, 0x39abdc4529b1661cULL};
+    std::uint64_t jumped[4] = {0, 0, 0, 0};
+    for (auto polynomial: jump_polynomial) {
+        for (int bit = 0; bit < 64; ++bit) {
+            if (polynomial & (std::uint64_t{1} << bit)) {
+                for (int i = 0; i < 4; ++i) {
+                    jumped[i] ^= state[i];
+                }
+            }
+            (*this)();
+        }
+    }
+    for (int i = 0; i < 4; ++i) {
+        state[i] = jumped[i];
+    }
+}
+
+AliasTable::AliasTable(const std::vector<double> &weights) {
+    const std::size_t n = weights.size();
+    if (n == 0) {
+        throw std::invalid_argument("Cannot construct an alias table without weights.");
+    }
+
+    double total = 0;
+    for (auto weight: weights) {
+        total += weight;
+    }
+
+    // scale the weights such that their mean is one
+    std::vector<double> scaled(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        scaled[i] = total > 0 ? weights[i] * static_cast<double>(n) / total : 1.;
+    }
+
+    probabilities.assign(n, 1.f);
+    aliases.resize(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        aliases[i] = static_cast<std::uint32_t>(i);
+    }
+
+    std::vector<std::uint32_t> small;
+    std::vector<std::uint32_t> large;
+    for (std::size_t i = 0; i < n; ++i) {
+        (scaled[i] < 1. ? small : large).push_back(static_cast<std::uint32_t>(i));
+    }
+
+    // pair every underfull column with an overfull one
+    while (!small.empty() && !large.empty()) {
+        auto less = small.back();
+        small.pop_back();
+        auto more = large.back();
+        large.pop_back();
+
+        probabilities[less] = static_cast<float>(scaled[less]);
+        aliases[less] = more;
+
+        scaled[more] = (scaled[more] + scaled[less]) - 1.;
+        (scaled[more] < 1. ? small : large).push_back(more);
+    }
+
+    // the remaining columns are full up to rounding errors
+    for (auto index: small) {
+        probabilities[index] = 1.f;
+    }
+    for (auto index: large) {
+        probabilities[index] = 1.f;
+    }
+}
+
+std::size_t AliasTable::sample(Xoshiro256 &rng) const {
+    auto column = static_cast<std::size_t>(rng.uniform_below(probabilities.size()));
+    return rng.uniform_float() < probabilities[column] ? column : aliases[column];
+}
+
+IntervalSampler::IntervalSampler(const Interval &interval, bool integer) : integer(integer) {
+    if (interval.is_empty()) {
+        throw std::invalid_argument("Cannot sample from an empty interval.");
+    }
+
+    std::vector<double> weights;
+    for (const auto &simple_interval: interval.simple_sets) {
+        if (std::isinf(simple_interval.lower) || std::isinf(simple_interval.upper)) {
+            throw std::invalid_argument("Cannot sample uniformly from an unbounded interval.");
+        }
+
+        // pieces without any value, such as open intervals between neighbouring floats, are never chosen
+        if (!contains_values(simple_interval, integer)) {
+            continue;
+        }
+
+        double weight;
+        if (integer) {
+            auto [first, last] = integer_bounds(simple_interval);
+            weight = last - first + 1;
+        } else {
+            weight = static_cast<double>(simple_interval.upper) - simple_interval.lower;
+        }
+        pieces.push_back(simple_interval);
+        weights.push_back(weight);
+        total_measure += weight;
+    }
+
+    if (pieces.empty()) {
+        throw std::invalid_argument(integer ? "The interval does not contain any integer." :
+                                    "The interval does not contain any float.");
+    }
+    alias_table = AliasTable(weights);
+}
+
+float IntervalSampler::sample(Xoshiro256 &rng) const {
+    const auto &piece = pieces[alias_table.sample(rng)];
+
+    if (integer) {
+        auto [first, last] = integer_bounds(piece);
+        auto offset = rng.uniform_below(static_cast<std::uint64_t>(last - first) + 1);
+        return static_cast<float>(first + static_cast<double>(offset));
+    }
+
+    if (piece.lower == piece.upper) {
+        return piece.lower;
+    }
+
+    // interpolate in double, where the width of finite pieces cannot overflow, and clamp the rounding to the piece
+    const double lower = piece.lower;
+    const double upper = piece.upper;
+    while (true) {
+        auto value = static_cast<float>(std::clamp(lower + (upper - lower) * rng.uniform_double(), lower, upper));
+
+        // reject the open borders that can be hit due to rounding
+        if ((value == piece.lower && piece.left == BorderType::OPEN) ||
+            (value == piece.upper && piece.right == BorderType::OPEN)) {
+            continue;
+        }
+        return value;
+    }
+}
+
+void IntervalSampler::sample(std::size_t count, Xoshiro256 &rng, float *out) const {
+    for (std::size_t i = 0; i < count; ++i) {
+        out[i] = sample(rng);
+    }
+}
+
+SetSampler::SetSampler(const Set &set) {
+    if (set.is_empty()) {
+        throw std::invalid_argument("Cannot sample from an empty set.");
+    }
+
+    const auto &all_elements = set.simple_sets.begin()->all_elements;
+    domain.assign(all_elements.begin(), all_elements.end());
+
+    for (const auto &simple_set: set.simple_sets) {
+        auto position = std::lower_bound(domain.begin(), domain.end(), simple_set.element);
+        element_indices.push_back(static_cast<std::size_t>(std::distance(domain.begin(), position)));
+    }
+    alias_table = AliasTable(std::vector<double>(element_indices.size(), 1.));
+}
+
+std::size_t SetSampler::sample(Xoshiro256 &rng) const {
+    return element_indices[alias_table.sample(rng)];
+}
+
+void SetSampler::sample(std::size_t count, Xoshiro256 &rng, std::size_t *out) const {
+    for (std::size_t i = 0; i < count; ++i) {
+        out[i] = sample(rng);
+    }
+}
+
+EventSampler::EventSampler(const Event &event) {
+    if (event.is_empty()) {
+        throw std::invalid_argument("Cannot sample from an empty event.");
+    }
+
+    std::set<VisitVariableVariant> variable_set;
+    for (const auto &simple_event: event.simple_sets) {
+        for (const auto &[variable, assignment]: simple_event.variable_assignments) {
+            variable_set.insert(variable);
+        }
+    }
+    all_variables = std::vector<VisitVariableVariant>(variable_set.begin(), variable_set.end());
+
+    std::vector<double> weights;
+    for (const auto &simple_event: event.simple_sets) {
+        std::vector<DimensionSampler> samplers;
+        double weight = 1;
+        bool has_values = true;
+
+        for (const auto &variable: all_variables) {
+            auto assignment = simple_event.variable_assignments.find(variable);
+            SetType value = assignment == simple_event.variable_assignments.end() ? full_domain_of(variable)
+                                                                                 : assignment->second;
+            if (std::holds_alternative<Interval>(value)) {
+                const auto &interval = std::get<Interval>(value);
+                bool integer = std::holds_alternative<Integer>(variable.variable_variant);
+
+                // boxes without any value, such as integer boxes between two integers, are never chosen
+                if (std::none_of(interval.simple_sets.begin(), interval.simple_sets.end(),
+                                 [integer](const auto &simple_interval) {
+                                     return contains_values(simple_interval, integer);
+                                 })) {
+                    has_values = false;
+                    break;
+                }
+                auto sampler = IntervalSampler(interval, integer);
+                weight *= sampler.measure();
+                samplers.emplace_back(std::move(sampler));
+            } else if (std::holds_alternative<Set>(value)) {
+                auto sampler = SetSampler(std::get<Set>(value));
+                weight *= sampler.measure();
+                samplers.emplace_back(std::move(sampler));
+            } else {
+                throw std::invalid_argument("Cannot sample from an unassigned variable.");
+            }
+        }
+
+        if (has_values) {
+            box_samplers.push_back(std::move(samplers));
+            weights.push_back(weight);
+        }
+    }
+    if (weights.empty()) {
+        throw std::invalid_argument("The event does not contain any value that can be sampled.");
+    }
+    alias_table = AliasTable(weights);
+}
+
+void EventSampler::sample(std::size_t count, Xoshiro256 &rng, const std::vector<SampleColumn> &columns) const {
+    if (columns.size() != all_variables.size()) {
+        throw std::invalid_argument("Exactly one column per variable is required.");
+    }
+
+    for (std::size_t i = 0; i < count; ++i) {
+        const auto &samplers = box_samplers[alias_table.sample(rng)];
+        for (std::size_t dimension = 0; dimension < samplers.size(); ++dimension) {
+            const auto &sampler = samplers[dimension];
+            if (std::holds_alternative<IntervalSampler>(sampler)) {
+                std::get<float *>(columns[dimension])[i] = std::get<IntervalSampler>(sampler).sample(rng);
+            } else {
+                std::get<std::size_t *>(columns[dimension])[i] = std::get<SetSampler>(sampler).sample(rng);
+            }
+        }
+    }
+}
@@ -2,6 +2,7 @@
 
 #include "sigma_algebra.h"
 #include "set.h"
+#include <stdexcept>
 
 
 SimpleSet SimpleSet::simple_set_intersection_with(const SimpleSet &other) const {
@@ -43,6 +44,60 @@ bool SimpleSet::simple_set_is_empty() const {
 }
 
 
+namespace {
+
+    /**
+     * @return The heap memory of a domain, which is counted once for all sets that share it.
+     */
+    MemoryFootprint shared_elements_memory_footprint(const SharedElements &all_elements) {
+        return string_set_memory_footprint(all_elements).as_domain().share(all_elements.storage_address());
+    }
+}
+
+MemoryFootprint SimpleSet::simple_set_memory_footprint() const {
+    MemoryFootprint result;
+    result.strings += string_heap_bytes(element);
+    result += shared_elements_memory_footprint(all_elements);
+    return result;
+}
+
+MemoryFootprint Set::memory_footprint() const {
+    auto result = CompositeSetWrapper::memory_footprint();
+    result += shared_elements_memory_footprint(all_elements);
+    result += empty_simple_set.memory_footprint();
+    return result;
+}
+
 Set Set::composite_set_simplify() {
     return *this;
 }
+
+Set union_all(const std::vector<Set> &sets) {
+    if (sets.empty()) {
+        return Set();
+    }
+    SimpleSetType<SimpleSet> elements;
+    for (const auto &set: sets) {
+        elements.insert(set.simple_sets.begin(), set.simple_sets.end());
+    }
+    return Set(elements, sets.front().all_elements);
+}
+
+Set intersection_all(const std::vector<Set> &sets) {
+    if (sets.empty()) {
+        throw std::invalid_argument("The intersection of no sets is undefined, since their domain is unknown.");
+    }
+    const auto &smallest = *std::min_element(sets.begin(), sets.end(), [](const Set &first, const Set &second) {
+        return first.simple_sets.size() < second.simple_sets.size();
+    });
+
+    SimpleSetType<SimpleSet> elements;
+    for (const auto &element: smallest.simple_sets) {
+        if (std::all_of(sets.begin(), sets.end(), [&element](const Set &set) {
+            return set.simple_sets.count(element) > 0;
+        })) {
+            elements.insert(elements.end(), element);
+        }
+    }
+    return Set(elements, smallest.all_elements);
+}
@@ -0,0 +1,353 @@
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <stdexcept>
+#include "text_format.h"
+
+namespace {
+    constexpr std::string_view EMPTY_SET = "∅";
+    constexpr std::string_view UNION = " u ";
+
+    std::string_view name_of(const VisitVariableVariant &variable) {
+        return std::visit([](const auto &variable_) -> std::string_view {
+            if constexpr (std::is_same_v<std::decay_t<decltype(variable_)>, std::monostate>) {
+                return {};
+            } else {
+                return variable_.name;
+            }
+        }, variable.variable_variant);
+    }
+}
+
+void TextWriter::write(float value) {
+    char characters[32];
+    auto [end, error] = std::to_chars(characters, characters + sizeof(characters), value);
+    buffer.append(characters, end);
+}
+
+void TextWriter::write(const SimpleInterval &simple_interval) {
+    if (simple_interval.is_empty()) {
+        write(EMPTY_SET);
+        return;
+    }
+    write(simple_interval.left == BorderType::OPEN ? '(' : '[');
+    write(simple_interval.lower);
+    write(", ");
+    write(simple_interval.upper);
+    write(simple_interval.right == BorderType::OPEN ? ')' : ']');
+}
+
+void TextWriter::write(const Interval &interval) {
+    if (interval.is_empty()) {
+        write(EMPTY_SET);
+        return;
+    }
+    for (auto simple_interval = interval.simple_sets.begin(); simple_interval != interval.simple_sets.end();
+         ++simple_interval) {
+        if (simple_interval != interval.simple_sets.begin()) {
+            write(UNION);
+        }
+        write(*simple_interval);
+    }
+}
+
+void TextWriter::write(const Set &set) {
+    if (set.is_empty()) {
+        write(EMPTY_SET);
+        return;
+    }
+    for (auto simple_set = set.simple_sets.begin(); simple_set != set.simple_sets.end(); ++simple_set) {
+        if (simple_set != set.simple_sets.begin()) {
+            write(UNION);
+        }
+        write(simple_set->element);
+    }
+}
+
+void TextWriter::write(const SetVariant &set_variant) {
+    if (std::holds_alternative<Interval>(set_variant)) {
+        write(std::get<Interval>(set_variant));
+    } else if (std::holds_alternative<Set>(set_variant)) {
+        write(std::get<Set>(set_variant));
+    } else {
+        write(EMPTY_SET);
+    }
+}
+
+void TextWriter::write(const SimpleEvent &simple_event) {
+    if (simple_event.is_empty()) {
+        write(EMPTY_SET);
+        return;
+    }
+    write('{');
+    for (auto assignment = simple_event.variable_assignments.begin();
+         assignment != simple_event.variable_assignments.end(); ++assignment) {
+        if (assignment != simple_event.variable_assignments.begin()) {
+            write(", ");
+        }
+        write(name_of(assignment->first));
+        write(": ");
+        write(assignment->second);
+    }
+    write('}');
+}
+
+void TextWriter::write(const Event &event) {
+    if (event.is_empty()) {
+        write(EMPTY_SET);
+        return;
+    }
+    for (auto simple_event = event.simple_sets.begin(); simple_event != event.simple_sets.end(); ++simple_event) {
+        if (simple_event != event.simple_sets.begin()) {
+            write(UNION);
+        }
+        write(*simple_event);
+    }
+}
+
+std::ostream &operator<<(std::ostream &stream, const SimpleInterval &simple_interval) {
+    return stream << format(simple_interval);
+}
+
+std::ostream &operator<<(std::ostream &stream, const Interval &interval) {
+    return stream << format(interval);
+}
+
+std::ostream &operator<<(std::ostream &stream, const Set &set) {
+    return stream << format(set);
+}
+
+std::ostream &operator<<(std::ostream &stream, const SimpleEvent &simple_event) {
+    return stream << format(simple_event);
+}
+
+std::ostream &operator<<(std::ostream &stream, const Event &event) {
+    return stream << format(event);
+}
+
+void TextParser::skip_spaces() {
+    while (offset < text.size() && text[offset] == ' ') {
+        ++offset;
+    }
+}
+
+bool TextParser::consume(std::string_view token) {
+    skip_spaces();
+    if (text.substr(offset, token.size()) == token) {
+        offset += token.size();
+        return true;
+    }
+    return false;
+}
+
+void TextParser::expect(std::string_view token) {
+    if (!consume(token)) {
+        fail("Expected '" + std::string(token) + "'");
+    }
+}
+
+bool TextParser::consume_union() {
+    auto before = offset;
+    skip_spaces();
+    if (offset > before && offset + 1 < text.size() && text[offset] == 'u' && text[offset + 1] == ' ') {
+        offset += 2;
+        return true;
+    }
+    offset = before;
+    return false;
+}
+
+bool TextParser::at_end() {
+    skip_spaces();
+    return offset == text.size();
+}
+
+void TextParser::fail(const std::string &message) const {
+    throw std::invalid_argument(message + " at position " + std::to_string(offset) + ".");
+}
+
+float TextParser::parse_float() {
+    skip_spaces();
+    float value;
+    auto [end, error] = std::from_chars(text.data() + offset, text.data() + text.size(), value);
+    if (error != std::errc()) {
+        fail("Expected a number");
+    }
+    if (std::isnan(value)) {
+        fail("Expected an ordered number instead of NaN");
+    }
+    offset = static_cast<std::size_t>(end - text.data());
+    return value;
+}
+
+SimpleInterval TextParser::parse_simple_interval() {
+    BorderType left;
+    if (consume("[")) {
+        left = BorderType::CLOSED;
+    } else if (consume("(")) {
+        left = BorderType::OPEN;
+    } else {
+        fail("Expected '[' or '('");
+    }
+
+    auto lower = parse_float();
+    expect(",");
+    auto upper = parse_float();
+
+    BorderType right;
+    if (consume("]")) {
+        right = BorderType::CLOSED;
+    } else if (consume(")")) {
+        right = BorderType::OPEN;
+    } else {
+        fail("Expected ']' or ')'");
+    }
+
+    if (lower > upper) {
+        fail("The lower bound exceeds the upper bound");
+    }
+    return SimpleInterval(lower, upper, left, right);
+}
+
+Interval TextParser::parse_interval() {
+    if (consume(EMPTY_SET)) {
+        return {};
+    }
+    SimpleSetType<SimpleInterval> simple_intervals;
+    do {
+        auto simple_interval = parse_simple_interval();
+        if (!simple_interval.is_empty()) {
+            simple_intervals.insert(simple_interval);
+        }
+    } while (consume_union());
+    return Interval(simple_intervals);
+}
+
+const std::vector<const std::string *> &TextParser::index_of(const SharedElements &all_elements) {
+    for (const auto &[domain, index]: domain_indices) {
+        if (domain.shares_storage_with(all_elements)) {
+            return index;
+        }
+    }
+    std::vector<const std::string *> index;
+    index.reserve(all_elements.size());
+    for (const auto &element: all_elements) {
+        index.push_back(&element);
+    }
+    return domain_indices.emplace_back(all_elements, std::move(index)).second;
+}
+
+Set TextParser::parse_set(const SharedElements &all_elements) {
+    if (consume(EMPTY_SET)) {
+        return Set(SimpleSetType<SimpleSet>(), all_elements);
+    }
+    SimpleSetType<SimpleSet> elements;
+    do {
+        skip_spaces();
+
+        // the element ends before the next union, comma or closing brace
+        auto end = std::min({text.find(UNION, offset), text.find(',', offset), text.find('}', offset),
+                             text.size()});
+        auto element = text.substr(offset, end - offset);
+        while (!element.empty() && element.back() == ' ') {
+            element.remove_suffix(1);
+        }
+        if (element.empty()) {
+            fail("Expected an element");
+        }
+        const auto &index = index_of(all_elements);
+        auto known_element = std::lower_bound(index.begin(), index.end(), element,
+                                              [](const std::string *known, std::string_view element) {
+                                                  return std::string_view(*known) < element;
+                                              });
+        if (known_element == index.end() || **known_element != element) {
+            fail("Unknown element '" + std::string(element) + "'");
+        }
+        offset += element.size();
+        elements.insert(SimpleSet(**known_element, all_elements));
+    } while (consume_union());
+    return Set(elements, all_elements);
+}
+
+SetVariant TextParser::parse_assignment(const VisitVariableVariant &variable) {
+    if (std::holds_alternative<Symbolic>(variable.variable_variant)) {
+        return parse_set(std::get<Symbolic>(variable.variable_variant).domain.all_elements);
+    }
+    if (std::holds_alternative<std::monostate>(variable.variable_variant)) {
+        fail("Cannot parse the assignment of an empty variable");
+    }
+    return parse_interval();
+}
+
+SimpleEvent TextParser::parse_simple_event(const std::vector<VisitVariableVariant> &variables) {
+    if (consume(EMPTY_SET)) {
+        return {};
+    }
+    expect("{");
+    VariableAssignmentType assignments;
+    if (consume("}")) {
+        return SimpleEvent(assignments);
+    }
+    do {
+        skip_spaces();
+        auto end = text.find(':', offset);
+        if (end == std::string_view::npos) {
+            fail("Expected ':'");
+        }
+        auto name = text.substr(offset, end - offset);
+        while (!name.empty() && name.back() == ' ') {
+            name.remove_suffix(1);
+        }
+
+        const VisitVariableVariant *variable = nullptr;
+        for (const auto &candidate: variables) {
+            if (name_of(candidate) == name) {
+                variable = &candidate;
+                break;
+            }
+        }
+        if (variable == nullptr) {
+            fail("Unknown variable '" + std::string(name) + "'");
+        }
+        offset = end + 1;
+        assignments.insert({*variable, parse_assignment(*variable)});
+    } while (consume(","));
+    expect("}");
+    return SimpleEvent(assignments);
+}
+
+Event TextParser::parse_event(const std::vector<VisitVariableVariant> &variables) {
+    if (consume(EMPTY_SET)) {
+        return {};
+    }
+    SimpleSetType<SimpleEvent> simple_events;
+    do {
+        simple_events.insert(parse_simple_event(variables));
+    } while (consume_union());
+    return Event(simple_events);
+}
+
+namespace {
+    template<typename T>
+    T parse_entire_text(TextParser &parser, T value) {
+        if (!parser.at_end()) {
+            throw std::invalid_argument("Unexpected text at position " + std::to_string(parser.position()) + ".");
+        }
+        return value;
+    }
+}
+
+Interval parse_interval(std::string_view text) {
+    TextParser parser(text);
+    return parse_entire_text(parser, parser.parse_interval());
+}
+
+Set parse_set(std::string_view text, const SharedElements &all_elements) {
+    TextParser parser(text);
+    return parse_entire_text(parser, parser.parse_set(all_elements));
+}
+
+Event parse_event(std::string_view text, const std::vector<VisitVariableVariant> &variables) {
+    TextParser parser(text);
+    return parse_entire_text(parser, parser.parse_event(variables));
+}
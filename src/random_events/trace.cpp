@@ -0,0 +1,379 @@
+#include <cstring>
+#include <mutex>
+#include <stdexcept>
+#include <vector>
+#include "trace.h"
+
+namespace {
+    constexpr char MAGIC[] = {'R', 'E', 'T', 'R', 'A', 'C', 'E', '1'};
+
+    enum class OperandKind : std::uint8_t {
+        INTERVAL,
+        SET,
+        EVENT
+    };
+
+    enum class VariableKind : std::uint8_t {
+        CONTINUOUS,
+        INTEGER,
+        SYMBOLIC
+    };
+
+    enum class AssignmentKind : std::uint8_t {
+        NONE,
+        INTERVAL,
+        SET
+    };
+
+    std::mutex trace_mutex;
+    std::FILE *trace_file = nullptr;
+
+    /**
+     * Appends the binary representation of operands to a buffer.
+     */
+    class Encoder {
+    public:
+        explicit Encoder(std::vector<char> &bytes) : bytes(bytes) {}
+
+        template<typename T>
+        void put(T value) {
+            auto position = bytes.size();
+            bytes.resize(position + sizeof(T));
+            std::memcpy(bytes.data() + position, &value, sizeof(T));
+        }
+
+        void put(const std::string &string) {
+            put(static_cast<std::uint32_t>(string.size()));
+            bytes.insert(bytes.end(), string.begin(), string.end());
+        }
+
+        void put(const Interval &interval) {
+            put(static_cast<std::uint32_t>(interval.simple_sets.size()));
+            for (const auto &simple_interval: interval.simple_sets) {
+                put(simple_interval.lower);
+                put(simple_interval.upper);
+                put(static_cast<std::uint8_t>((simple_interval.left == BorderType::CLOSED ? 1 : 0) |
+                                              (simple_interval.right == BorderType::CLOSED ? 2 : 0)));
+            }
+        }
+
+        void put(const std::set<std::string> &strings) {
+            put(static_cast<std::uint32_t>(strings.size()));
+            for (const auto &string: strings) {
+                put(string);
+            }
+        }
+
+        void put(const Set &set) {
+            put(set.all_elements.get());
+            put(static_cast<std::uint32_t>(set.simple_sets.size()));
+            for (const auto &simple_set: set.simple_sets) {
+                put(simple_set.element);
+            }
+        }
+
+        void put(const VisitVariableVariant &variable) {
+            const auto &variable_variant = variable.variable_variant;
+            if (std::holds_alternative<Continuous>(variable_variant)) {
+                put(VariableKind::CONTINUOUS);
+                put(std::get<Continuous>(variable_variant).name);
+            } else if (std::holds_alternative<Integer>(variable_variant)) {
+                put(VariableKind::INTEGER);
+                put(std::get<Integer>(variable_variant).name);
+            } else if (std::holds_alternative<Symbolic>(variable_variant)) {
+                put(VariableKind::SYMBOLIC);
+                put(std::get<Symbolic>(variable_variant).name);
+                put(std::get<Symbolic>(variable_variant).domain.all_elements.get());
+            } else {
+                throw std::invalid_argument("Cannot trace an empty variable.");
+            }
+        }
+
+        void put(const SetType &assignment) {
+            if (std::holds_alternative<Interval>(assignment)) {
+                put(AssignmentKind::INTERVAL);
+                put(std::get<Interval>(assignment));
+            } else if (std::holds_alternative<Set>(assignment)) {
+                put(AssignmentKind::SET);
+                put(std::get<Set>(assignment));
+            } else {
+                put(AssignmentKind::NONE);
+            }
+        }
+
+        void put(const Event &event) {
+            put(static_cast<std::uint32_t>(event.simple_sets.size()));
+            for (const auto &simple_event: event.simple_sets) {
+                put(static_cast<std::uint32_t>(simple_event.variable_assignments.size()));
+                for (const auto &[variable, assignment]: simple_event.variable_assignments) {
+                    put(variable);
+                    put(assignment);
+                }
+            }
+        }
+
+    private:
+        std::vector<char> &bytes;
+    };
+
+    /**
+     * Reads operands from a trace file.
+     */
+    class Decoder {
+    public:
+        explicit Decoder(std::FILE *file) : file(file) {}
+
+        void read(void *destination, std::size_t size) {
+            if (std::fread(destination, 1, size, file) != size) {
+                throw std::runtime_error("The trace is truncated.");
+            }
+        }
+
+        template<typename T>
+        T get() {
+            T value;
+            read(&value, sizeof(T));
+            return value;
+        }
+
+        std::string get_string() {
+            std::string result(get<std::uint32_t>(), '\0');
+            read(result.data(), result.size());
+            return result;
+        }
+
+        std::set<std::string> get_strings() {
+            std::set<std::string> result;
+            for (auto size = get<std::uint32_t>(); size > 0; --size) {
+                result.insert(get_string());
+            }
+            return result;
+        }
+
+        Interval get_interval() {
+            Interval result;
+            for (auto size = get<std::uint32_t>(); size > 0; --size) {
+                auto lower = get<float>();
+                auto upper = get<float>();
+                auto borders = get<std::uint8_t>();
+                result.simple_sets.insert(SimpleInterval(lower, upper,
+                                                         borders & 1 ? BorderType::CLOSED : BorderType::OPEN,
+                                                         borders & 2 ? BorderType::CLOSED : BorderType::OPEN));
+            }
+            return result;
+        }
+
+        Set get_set() {
+            auto all_elements = get_strings();
+            SimpleSetType<SimpleSet> elements;
+            for (auto size = get<std::uint32_t>(); size > 0; --size) {
+                elements.insert(SimpleSet(get_string(), all_elements));
+            }
+            return Set(elements, all_elements);
+        }
+
+        VisitVariableVariant get_variable() {
+            auto kind = get<VariableKind>();
+            auto name = get_string();
+            switch (kind) {
+                case VariableKind::CONTINUOUS:
+                    return VisitVariableVariant(Continuous(name));
+                case VariableKind::INTEGER:
+                    return VisitVariableVariant(Integer(name));
+                case VariableKind::SYMBOLIC:
+                    return VisitVariableVariant(Symbolic(name, Set(get_strings())));
+            }
+            throw std::runtime_error("The trace contains an unknown variable kind.");
+        }
+
+        SetType get_assignment() {
+            switch (get<AssignmentKind>()) {
+                case AssignmentKind::NONE:
+                    return std::monostate{};
+                case AssignmentKind::INTERVAL:
+                    return get_interval();
+                case AssignmentKind::SET:
+                    return get_set();
+            }
+            throw std::runtime_error("The trace contains an unknown assignment kind.");
+        }
+
+        Event get_event() {
+            Event result;
+            for (auto size = get<std::uint32_t>(); size > 0; --size) {
+                VariableAssignmentType assignments;
+                for (auto number_of_assignments = get<std::uint32_t>(); number_of_assignments > 0;
+                     --number_of_assignments) {
+                    auto variable = get_variable();
+                    assignments.insert({variable, get_assignment()});
+                }
+                result.simple_sets.insert(SimpleEvent(assignments));
+            }
+            return result;
+        }
+
+        TraceOperand get_operand(OperandKind kind) {
+            switch (kind) {
+                case OperandKind::INTERVAL:
+                    return get_interval();
+                case OperandKind::SET:
+                    return get_set();
+                case OperandKind::EVENT:
+                    return get_event();
+            }
+            throw std::runtime_error("The trace contains an unknown operand kind.");
+        }
+
+    private:
+        std::FILE *file;
+    };
+
+    OperandKind operand_kind(const Interval &) {
+        return OperandKind::INTERVAL;
+    }
+
+    OperandKind operand_kind(const Set &) {
+        return OperandKind::SET;
+    }
+
+    OperandKind operand_kind(const Event &) {
+        return OperandKind::EVENT;
+    }
+
+    bool is_binary(TracedOperation operation) {
+        return operation == TracedOperation::INTERSECTION || operation == TracedOperation::UNION ||
+               operation == TracedOperation::DIFFERENCE || operation == TracedOperation::CONTAINS;
+    }
+}
+
+template<typename T_CompositeSet>
+void record_operation(TracedOperation operation, const T_CompositeSet &first, const T_CompositeSet *second,
+                      std::chrono::nanoseconds duration) {
+
+    // binary operations whose second operand was not prepared, because recording started while they ran, are skipped
+    if (is_binary(operation) && second == nullptr) {
+        return;
+    }
+
+    // the operands are encoded before taking the lock, such that threads only wait for the write
+    thread_local std::vector<char> bytes;
+    bytes.clear();
+    Encoder encoder(bytes);
+    encoder.put(operation);
+    encoder.put(operand_kind(first));
+    encoder.put(static_cast<std::int64_t>(duration.count()));
+    encoder.put(first);
+    if (second != nullptr) {
+        encoder.put(*second);
+    }
+
+    std::lock_guard<std::mutex> lock(trace_mutex);
+    if (trace_file != nullptr) {
+        std::fwrite(bytes.data(), 1, bytes.size(), trace_file);
+    }
+}
+
+template void record_operation<Interval>(TracedOperation, const Interval &, const Interval *, std::chrono::nanoseconds);
+
+template void record_operation<Set>(TracedOperation, const Set &, const Set *, std::chrono::nanoseconds);
+
+template void record_operation<Event>(TracedOperation, const Event &, const Event *, std::chrono::nanoseconds);
+
+std::string to_string(TracedOperation operation) {
+    switch (operation) {
+        case TracedOperation::INTERSECTION:
+            return "intersection";
+        case TracedOperation::UNION:
+            return "union";
+        case TracedOperation::DIFFERENCE:
+            return "difference";
+        case TracedOperation::COMPLEMENT:
+            return "complement";
+        case TracedOperation::MAKE_DISJOINT:
+            return "make_disjoint";
+        case TracedOperation::CONTAINS:
+            return "contains";
+        case TracedOperation::IS_DISJOINT:
+            return "is_disjoint";
+        case TracedOperation::SIMPLIFY:
+            return "simplify";
+    }
+    return "unknown";
+}
+
+TraceResult TraceRecord::replay() const {
+    return std::visit([this](const auto &operand) -> TraceResult {
+        using T = std::decay_t<decltype(operand)>;
+        switch (operation) {
+            case TracedOperation::INTERSECTION:
+                return operand.intersection_with(std::get<T>(*second));
+            case TracedOperation::UNION:
+                return operand.union_with(std::get<T>(*second));
+            case TracedOperation::DIFFERENCE:
+                return operand.difference_with(std::get<T>(*second));
+            case TracedOperation::COMPLEMENT:
+                return operand.complement();
+            case TracedOperation::MAKE_DISJOINT:
+                return operand.make_disjoint();
+            case TracedOperation::CONTAINS:
+                return operand.contains(std::get<T>(*second));
+            case TracedOperation::IS_DISJOINT:
+                return operand.is_disjoint();
+            case TracedOperation::SIMPLIFY:
+                return T(operand).simplify();
+        }
+        throw std::invalid_argument("Cannot replay an unknown operation.");
+    }, first);
+}
+
+void TraceRecorder::start(const std::string &path) {
+    stop();
+    std::lock_guard<std::mutex> lock(trace_mutex);
+    trace_file = std::fopen(path.c_str(), "wb");
+    if (trace_file == nullptr) {
+        throw std::runtime_error("Cannot open the trace file " + path + ".");
+    }
+    std::fwrite(MAGIC, 1, sizeof(MAGIC), trace_file);
+    operation_tracing_enabled.store(true, std::memory_order_relaxed);
+}
+
+void TraceRecorder::stop() {
+    operation_tracing_enabled.store(false, std::memory_order_relaxed);
+    std::lock_guard<std::mutex> lock(trace_mutex);
+    if (trace_file != nullptr) {
+        std::fclose(trace_file);
+        trace_file = nullptr;
+    }
+}
+
+TraceReader::TraceReader(const std::string &path) : file(std::fopen(path.c_str(), "rb")) {
+    if (file == nullptr) {
+        throw std::runtime_error("Cannot open the trace file " + path + ".");
+    }
+    char magic[sizeof(MAGIC)];
+    if (std::fread(magic, 1, sizeof(magic), file) != sizeof(magic) || std::memcmp(magic, MAGIC, sizeof(MAGIC)) != 0) {
+        std::fclose(file);
+        throw std::runtime_error("The file " + path + " is not a trace.");
+    }
+}
+
+TraceReader::~TraceReader() {
+    std::fclose(file);
+}
+
+std::optional<TraceRecord> TraceReader::next() {
+    TracedOperation operation;
+    if (std::fread(&operation, 1, sizeof(operation), file) != sizeof(operation)) {
+        return std::nullopt;
+    }
+
+    Decoder decoder(file);
+    auto kind = decoder.get<OperandKind>();
+    auto duration = std::chrono::nanoseconds(decoder.get<std::int64_t>());
+    auto first = decoder.get_operand(kind);
+    std::optional<TraceOperand> second;
+    if (is_binary(operation)) {
+        second = decoder.get_operand(kind);
+    }
+    return TraceRecord{operation, std::move(first), std::move(second), duration};
+}
@@ -0,0 +1,46 @@
+#include "versioned_event.h"
+
+VersionedEvent VersionedEvent::with(const SimpleEvent &simple_event) const {
+    if (simple_event.is_empty()) {
+        return *this;
+    }
+    return VersionedEvent(simple_sets.insert(simple_event));
+}
+
+VersionedEvent VersionedEvent::without(const SimpleEvent &simple_event) const {
+    return VersionedEvent(simple_sets.erase(simple_event));
+}
+
+VersionedEvent VersionedEvent::replace(const SimpleEvent &simple_event, const Event &refinement) const {
+    auto result = simple_sets.erase(simple_event);
+    for (const auto &box: refinement.simple_sets) {
+        result = result.insert(box);
+    }
+    return VersionedEvent(std::move(result));
+}
+
+VersionedEvent VersionedEvent::difference_with(const SimpleEvent &other) const {
+    auto result = simple_sets;
+    for (const auto &box: simple_sets) {
+        if (box.intersection_with(other).is_empty()) {
+            continue;
+        }
+        result = result.erase(box);
+        for (const auto &remainder: box.difference_with(other).simple_sets) {
+            result = result.insert(remainder);
+        }
+    }
+    return VersionedEvent(std::move(result));
+}
+
+VersionedEvent VersionedEvent::difference_with(const Event &other) const {
+    auto result = *this;
+    for (const auto &box: other.simple_sets) {
+        result = result.difference_with(box);
+    }
+    return result;
+}
+
+Event VersionedEvent::to_event() const {
+    return Event(simple_sets.to_set());
+}
@@ -0,0 +1,19 @@
+#include "allocation_tracker.h"
+#include "allocation_hook.h"
+
+AllocationTracker::AllocationTracker() {
+    reset();
+}
+
+std::size_t AllocationTracker::allocations() const {
+    return thread_allocation_count() - allocations_at_start;
+}
+
+std::size_t AllocationTracker::bytes() const {
+    return thread_allocated_bytes() - bytes_at_start;
+}
+
+void AllocationTracker::reset() {
+    allocations_at_start = thread_allocation_count();
+    bytes_at_start = thread_allocated_bytes();
+}
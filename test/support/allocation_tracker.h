@@ -0,0 +1,58 @@
+#pragma once
+
+#include <cstddef>
+
+/**
+ * Counter of the allocations that the current thread makes within a scope.
+ *
+ * The counts come from the replaced global `operator new` of the `random_events_allocation_hook` library, such that
+ * every allocation of the library and the standard containers is seen. Allocations of other threads are ignored.
+ */
+class AllocationTracker {
+public:
+
+    /**
+     * Start counting from now.
+     */
+    AllocationTracker();
+
+    /**
+     * @return The number of allocations since construction or the last reset.
+     */
+    [[nodiscard]] std::size_t allocations() const;
+
+    /**
+     * @return The number of bytes allocated since construction or the last reset, ignoring deallocations.
+     */
+    [[nodiscard]] std::size_t bytes() const;
+
+    /**
+     * Restart counting from now.
+     */
+    void reset();
+
+private:
+    std::size_t allocations_at_start;
+    std::size_t bytes_at_start;
+};
+
+/**
+ * @return The number of allocations the current thread makes while running a function.
+ */
+template<typename Function>
+std::size_t count_allocations(Function &&function) {
+    AllocationTracker tracker;
+    function();
+    return tracker.allocations();
+}
+
+/**
+ * Expect that a statement makes at most the given number of allocations.
+ */
+#define EXPECT_ALLOCATIONS_AT_MOST(budget, statement) \
+    EXPECT_LE(count_allocations([&]() { statement; }), static_cast<std::size_t>(budget)) << #statement
+
+/**
+ * Expect that a statement does not allocate.
+ */
+#define EXPECT_NO_ALLOCATIONS(statement) EXPECT_ALLOCATIONS_AT_MOST(0, statement)
@@ -0,0 +1,81 @@
+#include "gtest/gtest.h"
+#include <cstdint>
+#include "allocation_tracker.h"
+#include "product_algebra.h"
+#include "text_format.h"
+
+TEST(AllocationBudget, Tracker){
+    AllocationTracker tracker;
+    auto *value = new int(1);
+    EXPECT_EQ(tracker.allocations(), 1);
+    EXPECT_GE(tracker.bytes(), sizeof(int));
+    delete value;
+    tracker.reset();
+    EXPECT_EQ(tracker.allocations(), 0);
+}
+
+TEST(AllocationBudget, OverAlignedTracker){
+    struct alignas(64) OverAligned {
+        char value[64];
+    };
+    AllocationTracker tracker;
+    auto *value = new OverAligned();
+    EXPECT_EQ(tracker.allocations(), 1);
+    EXPECT_GE(tracker.bytes(), sizeof(OverAligned));
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(value) % alignof(OverAligned), 0);
+    delete value;
+
+    auto *values = new OverAligned[3];
+    EXPECT_EQ(tracker.allocations(), 2);
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(values) % alignof(OverAligned), 0);
+    delete[] values;
+}
+
+TEST(AllocationBudget, SimpleInterval){
+    auto first = SimpleInterval(0, 2, BorderType::CLOSED, BorderType::OPEN);
+    auto second = SimpleInterval(1, 3, BorderType::OPEN, BorderType::CLOSED);
+    EXPECT_NO_ALLOCATIONS((void) first.simple_set_intersection_with(second));
+    EXPECT_NO_ALLOCATIONS((void) first.contains(1.5f));
+    EXPECT_NO_ALLOCATIONS((void) first.is_empty());
+    EXPECT_NO_ALLOCATIONS([[maybe_unused]] auto copy = first);
+}
+
+TEST(AllocationBudget, Interval){
+    auto first = closed(0, 2);
+    auto second = closed(1, 3);
+    auto fragmented = closed(0, 1).union_with(closed(2, 3)).union_with(closed(4, 5));
+
+    EXPECT_NO_ALLOCATIONS([[maybe_unused]] auto copy = fragmented);
+    EXPECT_NO_ALLOCATIONS((void) fragmented.is_disjoint());
+    EXPECT_NO_ALLOCATIONS((void) fragmented.contains(2.5f));
+    EXPECT_NO_ALLOCATIONS(Interval());
+    EXPECT_NO_ALLOCATIONS(for (const auto &pair: unique_pairs(fragmented.simple_sets)) { (void) pair; });
+
+    // the budgets are the current counts with little headroom, such that new copies and temporaries are noticed
+    EXPECT_ALLOCATIONS_AT_MOST(12, (void) first.intersection_with(second));
+    EXPECT_ALLOCATIONS_AT_MOST(60, (void) first.union_with(second));
+    EXPECT_ALLOCATIONS_AT_MOST(30, (void) first.difference_with(second));
+    EXPECT_ALLOCATIONS_AT_MOST(85, (void) fragmented.complement());
+    EXPECT_ALLOCATIONS_AT_MOST(30, (void) fragmented.make_disjoint());
+}
+
+TEST(AllocationBudget, Event){
+    auto x = Continuous("x");
+    auto y = Continuous("y");
+    auto box = SimpleEvent(std::map<VariableVariant, SetVariant>{{x, closed(0, 1)}, {y, closed(0, 1)}});
+    auto event = Event(box);
+
+    EXPECT_NO_ALLOCATIONS([[maybe_unused]] auto copy = event);
+    EXPECT_NO_ALLOCATIONS((void) event.is_empty());
+    EXPECT_ALLOCATIONS_AT_MOST(40, (void) event.intersection_with(event));
+}
+
+TEST(AllocationBudget, TextWriter){
+    auto interval = closed(0, 1).union_with(open(2, 3));
+    TextWriter writer;
+    writer.write(interval);
+
+    // the buffer is reused once it is large enough
+    writer.clear();
+    EXPECT_NO_ALLOCATIONS(writer.write(interval));
+}
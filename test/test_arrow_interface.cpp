@@ -0,0 +1,123 @@
+#include "gtest/gtest.h"
+#include "arrow_interface.h"
+#include <cstring>
+
+namespace {
+    auto arrow_x = Continuous("x");
+    auto arrow_n = Integer("n");
+    auto arrow_color = Symbolic("color", Set({"red", "green", "blue"}));
+
+    Set arrow_colors(const std::set<std::string> &elements) {
+        const auto &all_elements = arrow_color.domain.all_elements;
+        SimpleSetType<SimpleSet> simple_sets;
+        for (const auto &element: elements) {
+            simple_sets.insert(SimpleSet(element, all_elements));
+        }
+        return Set(simple_sets, all_elements);
+    }
+}
+
+TEST(ArrowInterface, Interval) {
+    auto interval = closed_open(0, 1).union_with(open_closed(2, 3)).union_with(singleton(5));
+
+    ArrowSchema schema{};
+    ArrowArray array{};
+    export_interval(interval, &schema, &array);
+    EXPECT_STREQ(schema.format, "+s");
+    ASSERT_EQ(schema.n_children, 3);
+    EXPECT_STREQ(schema.children[0]->name, "lower");
+    EXPECT_STREQ(schema.children[2]->format, "C");
+    EXPECT_EQ(array.length, 3);
+    EXPECT_EQ(static_cast<const float *>(array.children[1]->buffers[1])[1], 3);
+
+    auto imported = import_interval(&schema, &array);
+    EXPECT_EQ(imported, interval);
+    EXPECT_EQ(schema.release, nullptr);
+    EXPECT_EQ(array.release, nullptr);
+}
+
+TEST(ArrowInterface, ColumnsWithoutCopy) {
+    SimpleIntervalColumns columns(closed(0, 1).union_with(open(2, 3)));
+    const void *lower = columns.lower.data();
+    const void *borders = columns.borders.data();
+
+    ArrowSchema schema{};
+    ArrowArray array{};
+    export_columns(std::move(columns), &schema, &array);
+    EXPECT_EQ(array.children[0]->buffers[1], lower);
+    EXPECT_EQ(array.children[2]->buffers[1], borders);
+
+    // a slice of the array skips the first simple interval
+    array.offset = 1;
+    array.length = 1;
+    auto imported = import_columns(&schema, &array);
+    ASSERT_EQ(imported.size(), 1);
+    EXPECT_EQ(imported.at(0), SimpleInterval(2, 3, BorderType::OPEN, BorderType::OPEN));
+}
+
+TEST(ArrowInterface, Event) {
+    auto first = SimpleEvent(std::map<VariableVariant, SetVariant>{
+            {arrow_x, closed(0, 1).union_with(closed(2, 3))}, {arrow_color, arrow_colors({"red", "blue"})}});
+    auto second = SimpleEvent(std::map<VariableVariant, SetVariant>{
+            {arrow_x, open(5, 6)}, {arrow_n, closed(1, 4)}});
+    auto event = Event(SimpleSetType<SimpleEvent>{first, second});
+
+    ArrowSchema schema{};
+    ArrowArray array{};
+    export_event(event, &schema, &array);
+    EXPECT_STREQ(schema.format, "+s");
+    ASSERT_EQ(schema.n_children, 3);
+    EXPECT_EQ(array.length, 2);
+
+    // the symbolic column is dictionary encoded and null where the box does not assign it
+    auto color = std::find_if(schema.children, schema.children + 3, [](const ArrowSchema *child) {
+        return std::strcmp(child->name, "color") == 0;
+    }) - schema.children;
+    EXPECT_STREQ(schema.children[color]->children[0]->format, "i");
+    EXPECT_STREQ(schema.children[color]->children[0]->dictionary->format, "u");
+    EXPECT_EQ(array.children[color]->null_count, 1);
+    EXPECT_EQ(array.children[color]->children[0]->dictionary->length, 3);
+
+    auto imported = import_event(&schema, &array, {VisitVariableVariant(arrow_x), VisitVariableVariant(arrow_n),
+                                                  VisitVariableVariant(arrow_color)});
+    EXPECT_EQ(imported, event);
+}
+
+TEST(ArrowInterface, InvalidData) {
+    ArrowSchema schema{};
+    ArrowArray array{};
+    export_event(Event(SimpleEvent(std::map<VariableVariant, SetVariant>{{arrow_x, closed(0, 1)}})),
+                 &schema, &array);
+    EXPECT_THROW(import_event(&schema, &array, {VisitVariableVariant(arrow_n)}), std::invalid_argument);
+
+    // rejected data is released as well
+    EXPECT_EQ(schema.release, nullptr);
+    EXPECT_EQ(array.release, nullptr);
+
+    export_interval(closed(0, 1), &schema, &array);
+    EXPECT_THROW(import_event(&schema, &array, {VisitVariableVariant(arrow_x)}), std::invalid_argument);
+
+    export_event(Event(), &schema, &array);
+    EXPECT_THROW(import_interval(&schema, &array), std::invalid_argument);
+
+    // elements outside of the domain of their variable cannot be encoded
+    auto foreign = Event(SimpleEvent(std::map<VariableVariant, SetVariant>{
+            {arrow_color, Set(SimpleSet("purple", {"purple"}))}}));
+    EXPECT_THROW(export_event(foreign, &schema, &array), std::invalid_argument);
+
+    // null columns are rejected before they are read, and the release callbacks still free the exported columns
+    auto event = Event(SimpleEvent(std::map<VariableVariant, SetVariant>{{arrow_x, closed(0, 1)}}));
+    ArrowSchema *null_schemas[] = {nullptr};
+    export_event(event, &schema, &array);
+    schema.children = null_schemas;
+    EXPECT_THROW(import_event(&schema, &array, {VisitVariableVariant(arrow_x)}), std::invalid_argument);
+
+    ArrowArray *null_arrays[] = {nullptr};
+    export_event(event, &schema, &array);
+    array.children = null_arrays;
+    EXPECT_THROW(import_event(&schema, &array, {VisitVariableVariant(arrow_x)}), std::invalid_argument);
+
+    export_event(event, &schema, &array);
+    array.children = nullptr;
+    EXPECT_THROW(import_event(&schema, &array, {VisitVariableVariant(arrow_x)}), std::invalid_argument);
+}
@@ -0,0 +1,104 @@
+#include "gtest/gtest.h"
+#include "columnar_event.h"
+#include <random>
+
+namespace {
+    auto columnar_x = Continuous("x");
+    auto columnar_y = Continuous("y");
+
+    Event random_event(std::mt19937 &generator, std::size_t size) {
+        std::uniform_int_distribution<int> bound(0, 20);
+        std::uniform_int_distribution<int> border(0, 1);
+        auto random_interval = [&]() {
+            auto lower = static_cast<float>(bound(generator));
+            auto upper = lower + static_cast<float>(bound(generator) % 4);
+            return Interval(SimpleInterval{lower, upper, border(generator) ? BorderType::CLOSED : BorderType::OPEN,
+                                           border(generator) ? BorderType::CLOSED : BorderType::OPEN});
+        };
+        Event result;
+        for (std::size_t i = 0; i < size; ++i) {
+            auto box = SimpleEvent(std::map<VariableVariant, SetVariant>{{columnar_x, random_interval()},
+                                                                         {columnar_y, random_interval()}});
+            if (!box.is_empty()) {
+                result.simple_sets.insert(box);
+            }
+        }
+        return result;
+    }
+}
+
+TEST(ColumnarEvent, Conversion){
+    auto box1 = SimpleEvent(std::map<VariableVariant, SetVariant>{
+            {columnar_x, closed(0, 1).union_with(open(2, 3))}, {columnar_y, closed_open(0, 1)}});
+    auto box2 = SimpleEvent(std::map<VariableVariant, SetVariant>{{columnar_x, closed(5, 6)}});
+    auto event = Event(SimpleSetType<SimpleEvent>{box1, box2});
+
+    auto columnar = ColumnarEvent(event);
+    EXPECT_EQ(columnar.variables.size(), 2);
+    EXPECT_EQ(columnar.size(), 3);
+    EXPECT_TRUE(columnar.is_disjoint());
+
+    // the multi-piece box is split and the unassigned dimension takes the real line
+    auto expected = Event(SimpleSetType<SimpleEvent>{
+            SimpleEvent(std::map<VariableVariant, SetVariant>{{columnar_x, closed(0, 1)},
+                                                              {columnar_y, closed_open(0, 1)}}),
+            SimpleEvent(std::map<VariableVariant, SetVariant>{{columnar_x, open(2, 3)},
+                                                              {columnar_y, closed_open(0, 1)}}),
+            SimpleEvent(std::map<VariableVariant, SetVariant>{{columnar_x, closed(5, 6)}, {columnar_y, reals()}})});
+    EXPECT_EQ(columnar.to_event(), expected);
+    EXPECT_TRUE(columnar.to_event().difference_with(event).is_empty());
+    EXPECT_TRUE(event.difference_with(columnar.to_event()).is_empty());
+
+    auto symbolic = Symbolic("a", Set({"a", "b", "c"}));
+    EXPECT_THROW(ColumnarEvent(std::set<VisitVariableVariant>{VisitVariableVariant(symbolic)}),
+                 std::invalid_argument);
+}
+
+TEST(ColumnarEvent, OverlapMatchesSimpleEvents){
+    std::mt19937 generator(0);
+    auto first_event = random_event(generator, 45);
+    auto second_event = random_event(generator, 13);
+    auto first = ColumnarEvent(first_event);
+    auto second = ColumnarEvent(second_event);
+
+    std::vector<IndexPair> expected;
+    for (std::uint32_t j = 0; j < second.size(); ++j) {
+        for (std::uint32_t i = 0; i < first.size(); ++i) {
+            if (!first.box(i).intersection_with(second.box(j)).is_empty()) {
+                expected.emplace_back(i, j);
+                EXPECT_TRUE(first.boxes_overlap(i, second, j));
+            } else {
+                EXPECT_FALSE(first.boxes_overlap(i, second, j));
+            }
+        }
+    }
+    EXPECT_EQ(first.overlapping_pairs(second), expected);
+    EXPECT_EQ(first.intersects(second), !expected.empty());
+
+    std::vector<std::uint32_t> positions;
+    first.overlapping_boxes(second, 0, positions);
+    std::vector<std::uint32_t> expected_positions;
+    for (const auto &[i, j]: expected) {
+        if (j == 0) {
+            expected_positions.push_back(i);
+        }
+    }
+    EXPECT_EQ(positions, expected_positions);
+
+    // the scalar and the vectorized kernel agree
+    for (std::size_t begin: {0, 3}) {
+        std::vector<std::uint8_t> scalar;
+        box_overlap_mask_scalar(first.dimensions, begin, second.dimensions, 1, scalar);
+        if (avx2_available()) {
+            std::vector<std::uint8_t> vectorized;
+            box_overlap_mask_avx2(first.dimensions, begin, second.dimensions, 1, vectorized);
+            EXPECT_EQ(vectorized, scalar);
+        }
+    }
+
+    EXPECT_EQ(first.is_disjoint(), first_event.is_disjoint());
+    EXPECT_TRUE(ColumnarEvent(first_event.make_disjoint()).is_disjoint());
+    EXPECT_THROW((void) first.intersects(
+                         ColumnarEvent(std::set<VisitVariableVariant>{VisitVariableVariant(columnar_x)})),
+                 std::invalid_argument);
+}
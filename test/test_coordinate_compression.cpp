@@ -0,0 +1,87 @@
+#include "gtest/gtest.h"
+#include "coordinate_compression.h"
+#include <cmath>
+
+namespace {
+    auto compressed_x = Continuous("x");
+    auto compressed_y = Continuous("y");
+    auto compressed_color = Symbolic("color", Set({"red", "green", "blue"}));
+
+    Set colors(const std::set<std::string> &elements) {
+        const auto &all_elements = compressed_color.domain.all_elements;
+        SimpleSetType<SimpleSet> simple_sets;
+        for (const auto &element: elements) {
+            simple_sets.insert(SimpleSet(element, all_elements));
+        }
+        return Set(simple_sets, all_elements);
+    }
+
+    Event box(const Interval &x, const Interval &y, const Set &color) {
+        return Event(SimpleEvent(std::map<VariableVariant, SetVariant>{{compressed_x, x}, {compressed_y, y},
+                                                                       {compressed_color, color}}));
+    }
+
+    bool equal_sets(const Event &first, const Event &second) {
+        return first.difference_with(second).is_empty() && second.difference_with(first).is_empty();
+    }
+}
+
+TEST(CoordinateCompression, Dictionary){
+    auto first = box(closed(0, 1), open(2, 3), colors({"red"}));
+    auto second = box(closed_open(1, 4), reals(), colors({"red", "blue"}));
+    CoordinateCompression compression({first, second});
+
+    EXPECT_EQ(compression.variables.size(), 3);
+    auto color_dimension = static_cast<std::size_t>(
+            std::find(compression.variables.begin(), compression.variables.end(),
+                      VisitVariableVariant(compressed_color)) - compression.variables.begin());
+    auto x_dimension = static_cast<std::size_t>(
+            std::find(compression.variables.begin(), compression.variables.end(),
+                      VisitVariableVariant(compressed_x)) - compression.variables.begin());
+    EXPECT_EQ(compression.endpoints[x_dimension], (std::vector<float>{0, 1, 4}));
+    EXPECT_EQ(compression.elements[color_dimension], (std::vector<std::string>{"blue", "green", "red"}));
+    EXPECT_EQ(compression.cells()[x_dimension], 7);
+
+    // [0, 1] covers the points 0 and 1 and the gap between them, which are the cells 1 to 3
+    auto compressed = compression.compress(first);
+    ASSERT_EQ(compressed.boxes.size(), 1);
+    EXPECT_EQ(compressed.boxes[0][x_dimension], GridSet{0b1110});
+    EXPECT_EQ(compressed.boxes[0][color_dimension], GridSet{0b100});
+
+    EXPECT_EQ(compression.decompress(compressed), first);
+    EXPECT_TRUE(equal_sets(compression.decompress(compression.compress(second)), second));
+
+    EXPECT_THROW(compression.compress(box(closed(0, 2), reals(), colors({"red"}))), std::invalid_argument);
+}
+
+TEST(CoordinateCompression, Operations){
+    auto first = box(closed(0, 2), closed(0, 2), colors({"red", "green"}));
+    auto second = box(open(1, 3), closed_open(1, 3), colors({"green", "blue"}));
+    auto third = box(closed(0, 3), singleton(2), colors({"blue"}));
+    auto event = first.union_with(second);
+    CoordinateCompression compression({first, second, third});
+
+    auto compressed = compression.compress(event);
+    auto compressed_third = compression.compress(third);
+    EXPECT_TRUE(compressed.is_disjoint());
+
+    EXPECT_TRUE(equal_sets(compression.decompress(compressed.intersection_with(compressed_third)),
+                           event.intersection_with(third)));
+    EXPECT_TRUE(equal_sets(compression.decompress(compressed.difference_with(compressed_third)),
+                           event.difference_with(third)));
+    EXPECT_TRUE(equal_sets(compression.decompress(compressed.union_with(compressed_third)),
+                           event.union_with(third)));
+    EXPECT_TRUE(equal_sets(compression.decompress(compressed.complement()), event.complement()));
+    EXPECT_TRUE(equal_sets(compression.decompress(compressed.complement().complement()), event));
+
+    auto overlapping = compression.compress(first);
+    overlapping.boxes.push_back(compression.compress(second).boxes.front());
+    EXPECT_FALSE(overlapping.is_disjoint());
+    auto disjoint = overlapping.make_disjoint();
+    EXPECT_TRUE(disjoint.is_disjoint());
+    EXPECT_TRUE(equal_sets(compression.decompress(disjoint), event));
+
+    EXPECT_DOUBLE_EQ(compression.measure(compression.compress(first)), first.simple_sets.begin()->measure());
+    EXPECT_DOUBLE_EQ(compression.measure(disjoint), compression.measure(compressed));
+    EXPECT_TRUE(std::isinf(compression.measure(compressed.complement())));
+}
@@ -0,0 +1,98 @@
+#include "gtest/gtest.h"
+#include "integer_set.h"
+
+TEST(IntegerSet, InsertAndContains){
+    auto set = IntegerSet{5, -3, 70000, 5};
+    EXPECT_EQ(set.cardinality(), 3);
+    EXPECT_TRUE(set.contains(-3));
+    EXPECT_TRUE(set.contains(70000));
+    EXPECT_FALSE(set.contains(4));
+    EXPECT_EQ(set.to_vector(), (std::vector<std::int32_t>{-3, 5, 70000}));
+}
+
+TEST(IntegerSet, ContainerKinds){
+    // dense and irregular values are stored as bitmap, clustered values as runs and few values as array
+    IntegerSet even;
+    for (std::int32_t value = 0; value < 20000; value += 2) {
+        even.insert(value);
+    }
+    EXPECT_EQ(even.container_kinds(), std::vector<ContainerKind>{ContainerKind::BITMAP});
+    EXPECT_EQ(even.cardinality(), 10000);
+
+    auto dense_range = IntegerSet::range(0, 1000000);
+    EXPECT_EQ(dense_range.cardinality(), 1000001);
+    for (auto kind: dense_range.container_kinds()) {
+        EXPECT_EQ(kind, ContainerKind::RUN);
+    }
+    EXPECT_LT(dense_range.memory_footprint().total(), 1024);
+
+    auto few = IntegerSet{1, 100, 1000};
+    EXPECT_EQ(few.container_kinds(), std::vector<ContainerKind>{ContainerKind::ARRAY});
+}
+
+TEST(IntegerSet, Operations){
+    IntegerSet even;
+    for (std::int32_t value = 0; value < 20000; value += 2) {
+        even.insert(value);
+    }
+    auto range = IntegerSet::range(10000, 30000);
+    auto few = IntegerSet{1, 2, 3, 25000};
+
+    auto united = even.union_with(range);
+    EXPECT_EQ(united.cardinality(), 5000 + 20001);
+    EXPECT_TRUE(united.contains(10001));
+    EXPECT_TRUE(united.contains(2));
+    EXPECT_FALSE(united.contains(3));
+
+    auto intersection = even.intersection_with(range);
+    EXPECT_EQ(intersection.cardinality(), 5000);
+    EXPECT_EQ(intersection.container_kinds(), std::vector<ContainerKind>{ContainerKind::BITMAP});
+
+    auto difference = range.difference_with(even);
+    EXPECT_EQ(difference.cardinality(), 20001 - 5000);
+    EXPECT_FALSE(difference.contains(10000));
+    EXPECT_TRUE(difference.contains(10001));
+    EXPECT_TRUE(difference.contains(25000));
+
+    EXPECT_EQ(few.intersection_with(even), (IntegerSet{2}));
+    EXPECT_EQ(few.intersection_with(range), (IntegerSet{25000}));
+    EXPECT_EQ(range.difference_with(few).cardinality(), 20000);
+    EXPECT_EQ(range.union_with(few).cardinality(), 20004);
+    EXPECT_TRUE(range.difference_with(range).is_empty());
+
+    // runs split by runs
+    auto holes = IntegerSet::range(0, 100).difference_with(IntegerSet::range(10, 20))
+            .difference_with(IntegerSet::range(50, 60));
+    EXPECT_EQ(holes.cardinality(), 101 - 22);
+    EXPECT_EQ(holes.to_interval(), closed(0, 9).union_with(closed(21, 49)).union_with(closed(61, 100)));
+}
+
+TEST(IntegerSet, Rank){
+    auto set = IntegerSet::range(-5, 5).union_with(IntegerSet{100000});
+    EXPECT_EQ(set.rank(-6), 0);
+    EXPECT_EQ(set.rank(-5), 1);
+    EXPECT_EQ(set.rank(0), 6);
+    EXPECT_EQ(set.rank(99999), 11);
+    EXPECT_EQ(set.rank(100000), 12);
+
+    IntegerSet even;
+    for (std::int32_t value = 0; value < 20000; value += 2) {
+        even.insert(value);
+    }
+    EXPECT_EQ(even.rank(63), 32);
+    EXPECT_EQ(even.rank(64), 33);
+}
+
+TEST(IntegerSet, Interval){
+    auto interval = open(0.5, 3).union_with(closed(65535, 65537));
+    auto set = IntegerSet::from_interval(interval);
+    EXPECT_EQ(set.to_vector(), (std::vector<std::int32_t>{1, 2, 65535, 65536, 65537}));
+    EXPECT_EQ(set.to_interval(), closed(1, 2).union_with(closed(65535, 65537)));
+    EXPECT_THROW(IntegerSet::from_interval(closed(0, std::numeric_limits<float>::infinity())),
+                 std::invalid_argument);
+
+    // 2^24 + 1 is the first integer that has no float representation
+    EXPECT_EQ(IntegerSet::range(1 << 24, (1 << 24) + 2).to_interval(), closed(1 << 24, (1 << 24) + 2));
+    EXPECT_THROW(IntegerSet({(1 << 24) + 1}).to_interval(), std::invalid_argument);
+    EXPECT_THROW(IntegerSet::range(0, (1 << 24) + 1).to_interval(), std::invalid_argument);
+}
@@ -1,5 +1,8 @@
 #include "gtest/gtest.h"
 #include "interval.h"
+#include "allocation_hook.h"
+#include <cstring>
+#include <thread>
 
 
 TEST(AtomicIntervalCreationTestSuite, SimpleInterval){
@@ -208,3 +211,229 @@ TEST(IntervalContainment, Interval){
 
 
 }
+
+TEST(AtomicIntervalCopyTestSuite, SimpleInterval){
+    auto intervals = std::vector<SimpleInterval>{SimpleInterval{0.0, 1.0, BorderType::OPEN, BorderType::CLOSED},
+                                                 SimpleInterval{2.0, 3.0, BorderType::CLOSED, BorderType::OPEN}};
+    std::vector<SimpleInterval> copied(intervals.size());
+    std::memcpy(copied.data(), intervals.data(), intervals.size() * sizeof(SimpleInterval));
+    EXPECT_EQ(copied, intervals);
+    EXPECT_EQ(copied[0].right, BorderType::CLOSED);
+    EXPECT_EQ(copied[1].left, BorderType::CLOSED);
+    EXPECT_TRUE(copied[0] < copied[1]);
+    EXPECT_TRUE(copied[1] > copied[0]);
+}
+
+TEST(IntervalBudget, Interval){
+    auto interval = closed(0, 1).union_with(closed(2, 3));
+    auto other = Interval{SimpleSetType<SimpleInterval>{SimpleInterval{0.5, 2.5, BorderType::CLOSED, BorderType::CLOSED},
+                                                        SimpleInterval{4, 5, BorderType::CLOSED, BorderType::CLOSED}}};
+
+    auto [union_, status] = interval.union_with(other, OperationBudget());
+    EXPECT_EQ(status, OperationStatus::OK);
+    EXPECT_EQ(union_, interval.union_with(other));
+
+    auto piece_budget = OperationBudget();
+    piece_budget.max_simple_sets = 1;
+    auto [limited_union, limited_status] = interval.union_with(other, piece_budget);
+    EXPECT_EQ(limited_status, OperationStatus::BUDGET_EXCEEDED);
+    EXPECT_TRUE(limited_union.is_empty());
+
+    std::atomic<bool> cancelled = true;
+    auto cancellable_budget = OperationBudget();
+    cancellable_budget.cancellation_token = &cancelled;
+    EXPECT_EQ(std::get<1>(interval.complement(cancellable_budget)), OperationStatus::CANCELLED);
+
+    auto expired_budget = OperationBudget::with_timeout(std::chrono::seconds(-1));
+    EXPECT_EQ(std::get<1>(interval.difference_with(other, expired_budget)), OperationStatus::DEADLINE_EXCEEDED);
+}
+
+TEST(IntervalMemoryFootprint, Interval){
+    EXPECT_EQ(empty().memory_footprint().total(), 0);
+    auto interval = closed(0, 1).union_with(closed(2, 3));
+    auto footprint = interval.memory_footprint();
+    EXPECT_EQ(footprint.container_nodes, 2 * tree_node_bytes<SimpleInterval>());
+    EXPECT_EQ(footprint.strings, 0);
+    EXPECT_EQ(footprint.domains, 0);
+}
+
+TEST(IntervalCoarsen, Interval){
+    auto interval = closed(0, 1).union_with(closed(1.1, 2)).union_with(closed(3, 4)).union_with(closed(10, 11));
+
+    auto [by_epsilon, epsilon_error] = interval.coarsen(10, 0.5);
+    EXPECT_EQ(by_epsilon.simple_sets.size(), 3);
+    EXPECT_NEAR(epsilon_error, 0.1, 1e-6);
+    EXPECT_TRUE(by_epsilon.contains(interval));
+
+    auto [by_pieces, pieces_error] = interval.coarsen(2);
+    EXPECT_EQ(by_pieces, closed(0, 4).union_with(closed(10, 11)));
+    EXPECT_NEAR(pieces_error, 1.1, 1e-6);
+
+    auto [single, single_error] = interval.coarsen(1);
+    EXPECT_EQ(single, closed(0, 11));
+    EXPECT_NEAR(single_error, single.measure() - interval.measure(), 1e-5);
+
+    EXPECT_THROW(interval.coarsen(0), std::invalid_argument);
+}
+
+TEST(IntervalCopyOnWrite, Interval){
+    auto interval = closed(0, 1).union_with(closed(2, 3));
+    auto copy = interval;
+    EXPECT_TRUE(copy.simple_sets.shares_storage_with(interval.simple_sets));
+
+    copy = copy.union_with(closed(5, 6));
+    EXPECT_FALSE(copy.simple_sets.shares_storage_with(interval.simple_sets));
+    EXPECT_EQ(interval, closed(0, 1).union_with(closed(2, 3)));
+
+    // concurrent readers of copies that share their storage
+    std::vector<std::thread> readers;
+    std::atomic<int> contained{0};
+    for (int i = 0; i < 4; ++i) {
+        readers.emplace_back([&contained, shared = interval]() {
+            for (int j = 0; j < 100; ++j) {
+                auto local = shared;
+                contained += local.contains(2.5f) ? 1 : 0;
+            }
+        });
+    }
+    for (auto &reader: readers) {
+        reader.join();
+    }
+    EXPECT_EQ(contained.load(), 400);
+}
+
+TEST(IntervalIsDisjoint, Interval){
+    SimpleSetType<SimpleInterval> pieces;
+    for (int i = 0; i < 10000; ++i) {
+        pieces.insert(SimpleInterval(2.f * i, 2.f * i + 1, BorderType::CLOSED, BorderType::OPEN));
+    }
+    auto interval = Interval(pieces);
+
+    auto allocations_before = allocation_count();
+    EXPECT_TRUE(interval.is_disjoint());
+    EXPECT_EQ(allocation_count(), allocations_before);
+
+    // a piece that overlaps a piece that is not its direct predecessor
+    auto nested = Interval(SimpleSetType<SimpleInterval>{SimpleInterval(0, 10, BorderType::CLOSED, BorderType::CLOSED),
+                                                         SimpleInterval(1, 2, BorderType::CLOSED, BorderType::CLOSED),
+                                                         SimpleInterval(3, 4, BorderType::CLOSED, BorderType::CLOSED)});
+    EXPECT_FALSE(nested.is_disjoint());
+
+    auto touching = Interval(SimpleSetType<SimpleInterval>{SimpleInterval(0, 1, BorderType::CLOSED, BorderType::OPEN),
+                                                           SimpleInterval(1, 2, BorderType::CLOSED, BorderType::CLOSED)});
+    EXPECT_TRUE(touching.is_disjoint());
+    auto closed_touching = Interval(SimpleSetType<SimpleInterval>{
+            SimpleInterval(0, 1, BorderType::CLOSED, BorderType::CLOSED),
+            SimpleInterval(1, 2, BorderType::CLOSED, BorderType::CLOSED)});
+    EXPECT_FALSE(closed_touching.is_disjoint());
+}
+
+TEST(UniquePairs, Interval){
+    auto interval = closed(0, 1).union_with(closed(2, 3)).union_with(closed(4, 5));
+    std::vector<std::pair<float, float>> lower_bounds;
+    for (const auto &[first, second]: unique_pairs(interval.simple_sets)) {
+        lower_bounds.emplace_back(first.lower, second.lower);
+    }
+    EXPECT_EQ(lower_bounds, (std::vector<std::pair<float, float>>{{0, 2}, {0, 4}, {2, 4}}));
+
+    auto single = closed(0, 1);
+    auto single_pairs = unique_pairs(single.simple_sets);
+    EXPECT_EQ(std::distance(single_pairs.begin(), single_pairs.end()), 0);
+    EXPECT_EQ(interval.to_string(), "[0.000000, 1.000000] u [2.000000, 3.000000] u [4.000000, 5.000000]");
+}
+
+TEST(UnionAll, Interval){
+    std::vector<Interval> intervals{closed(0, 1), open(1, 2), closed_open(5, 6), closed(3, 4).union_with(singleton(6)),
+                                    open(3, 3.5), empty(), open(7, 8), open(8, 9)};
+    auto expected = empty();
+    for (const auto &interval: intervals) {
+        expected = expected.union_with(interval);
+    }
+    auto result = union_all(intervals);
+    EXPECT_EQ(result, expected);
+    EXPECT_EQ(result, closed_open(0, 2).union_with(closed(3, 4)).union_with(closed(5, 6))
+            .union_with(open(7, 8)).union_with(open(8, 9)));
+
+    // simple intervals that start at the same point with different borders
+    EXPECT_EQ(union_all({open_closed(0, 2), closed(0, 1)}), closed(0, 2));
+    EXPECT_EQ(union_all({open(0, 1), open_closed(0, 1)}), open_closed(0, 1));
+    EXPECT_TRUE(union_all({}).is_empty());
+}
+
+TEST(IntersectionAll, Interval){
+    std::vector<Interval> intervals{closed(0, 10), closed_open(1, 3).union_with(open(4, 8)),
+                                    closed(2, 5).union_with(closed(6, 7))};
+    auto expected = intervals.front();
+    for (const auto &interval: intervals) {
+        expected = expected.intersection_with(interval);
+    }
+    auto result = intersection_all(intervals);
+    EXPECT_EQ(result, expected);
+    EXPECT_EQ(result, closed_open(2, 3).union_with(open_closed(4, 5)).union_with(closed(6, 7)));
+
+    EXPECT_EQ(intersection_all({closed(0, 1), closed_open(0, 1)}), closed_open(0, 1));
+    EXPECT_EQ(intersection_all({closed(0, 1), closed(1, 2)}), singleton(1));
+    EXPECT_TRUE(intersection_all({open(0, 1), open(1, 2)}).is_empty());
+    EXPECT_EQ(intersection_all({}), reals());
+}
+
+TEST(LazyComplement, Interval){
+    auto interval = closed(0, 1).union_with(open(2, 3));
+    auto complement = interval.lazy_complement();
+    EXPECT_TRUE(complement.complemented_set().simple_sets.shares_storage_with(interval.simple_sets));
+
+    EXPECT_TRUE(complement.contains(1.5f));
+    EXPECT_TRUE(complement.contains(2.f));
+    EXPECT_FALSE(complement.contains(1.f));
+    EXPECT_TRUE(complement.contains(closed(4, 5)));
+    EXPECT_FALSE(complement.contains(closed(0.5, 1.5)));
+
+    auto other = closed(0.5, 2.5);
+    auto explicit_complement = interval.complement();
+    EXPECT_EQ(complement.materialize(), explicit_complement);
+    EXPECT_EQ(complement.complement(), interval);
+    EXPECT_EQ(complement.intersection_with(other), explicit_complement.intersection_with(other));
+    EXPECT_EQ(other.intersection_with(complement), other.intersection_with(explicit_complement));
+    EXPECT_EQ(other.difference_with(complement), other.difference_with(explicit_complement));
+    EXPECT_EQ(complement.difference_with(other).materialize(), explicit_complement.difference_with(other));
+    EXPECT_EQ(complement.union_with(other).materialize(), explicit_complement.union_with(other));
+
+    auto other_complement = other.lazy_complement();
+    EXPECT_EQ(complement.intersection_with(other_complement).materialize(),
+              explicit_complement.intersection_with(other.complement()));
+    EXPECT_EQ(complement.union_with(other_complement).materialize(),
+              explicit_complement.union_with(other.complement()));
+    EXPECT_EQ(complement.difference_with(other_complement), explicit_complement.difference_with(other.complement()));
+}
+
+TEST(BoundingHull, Interval){
+    auto interval = Interval(SimpleSetType<SimpleInterval>{SimpleInterval(0, 1, BorderType::OPEN, BorderType::OPEN),
+                                                           SimpleInterval(0, 0.5, BorderType::CLOSED, BorderType::OPEN),
+                                                           SimpleInterval(2, 3, BorderType::OPEN, BorderType::CLOSED)});
+    EXPECT_EQ(interval.bounding_hull(), SimpleInterval(0, 3, BorderType::CLOSED, BorderType::CLOSED));
+    EXPECT_TRUE(empty().bounding_hull().is_empty());
+
+    // copies share the hull and modifications drop it
+    auto copy = interval;
+    EXPECT_EQ(&copy.bounding_hull(), &interval.bounding_hull());
+    copy.simple_sets.insert(SimpleInterval(4, 5, BorderType::OPEN, BorderType::OPEN));
+    EXPECT_EQ(copy.bounding_hull(), SimpleInterval(0, 5, BorderType::CLOSED, BorderType::OPEN));
+    EXPECT_EQ(interval.bounding_hull().upper, 3);
+    auto unique = closed(0, 1);
+    EXPECT_EQ(unique.bounding_hull().upper, 1);
+    unique.simple_sets.insert(SimpleInterval(2, 4, BorderType::CLOSED, BorderType::CLOSED));
+    EXPECT_EQ(unique.bounding_hull().upper, 4);
+
+    EXPECT_TRUE(closed(0, 1).bounding_hulls_disjoint(open(1, 2)));
+    EXPECT_FALSE(closed(0, 1).bounding_hulls_disjoint(closed(1, 2)));
+    EXPECT_TRUE(closed(0, 10).bounding_hull_contains(closed(2, 3).union_with(closed(5, 6))));
+    EXPECT_FALSE(closed(0, 10).bounding_hull_contains(closed(2, 11)));
+
+    // the early outs agree with the full operations
+    auto far = closed(10, 11);
+    EXPECT_TRUE(interval.intersection_with(far).is_empty());
+    EXPECT_EQ(interval.difference_with(far), interval.make_disjoint());
+    EXPECT_FALSE(interval.contains(far));
+    EXPECT_FALSE(closed(0, 1).union_with(closed(2, 3)).contains(closed(0.5, 2.5)));
+    EXPECT_TRUE(closed(0, 1).union_with(closed(2, 3)).contains(closed(0.5, 1).union_with(closed(2, 2.5))));
+}
@@ -0,0 +1,55 @@
+#include "gtest/gtest.h"
+#include "interval_index.h"
+#include <algorithm>
+#include <random>
+
+TEST(IntervalIndex, Stab){
+    auto intervals = std::vector<Interval>{closed(0, 1),
+                                           open(1, 2).union_with(closed(3, 4)),
+                                           closed_open(1, 3),
+                                           reals(),
+                                           empty()};
+    auto index = IntervalIndex(intervals);
+    EXPECT_EQ(index.size(), 5);
+
+    auto ids = index.stab(1);
+    std::sort(ids.begin(), ids.end());
+    EXPECT_EQ(ids, (std::vector<std::size_t>{0, 2, 3}));
+
+    ids = index.stab(3);
+    std::sort(ids.begin(), ids.end());
+    EXPECT_EQ(ids, (std::vector<std::size_t>{1, 3}));
+
+    ids = index.stab(-10);
+    EXPECT_EQ(ids, (std::vector<std::size_t>{3}));
+}
+
+TEST(IntervalIndex, MatchesContains){
+    std::mt19937 generator(0);
+    std::uniform_real_distribution<float> distribution(0, 100);
+    std::vector<Interval> intervals;
+    for (int i = 0; i < 200; ++i) {
+        float lower = std::round(distribution(generator));
+        float upper = lower + std::round(distribution(generator) / 10);
+        intervals.push_back(i % 2 == 0 ? closed(lower, upper) : open_closed(lower, upper));
+    }
+    auto index = IntervalIndex(intervals);
+
+    std::vector<float> values;
+    for (int value = -1; value <= 111; ++value) {
+        values.push_back(static_cast<float>(value));
+        values.push_back(static_cast<float>(value) + 0.5f);
+    }
+    auto results = index.stab_all(values);
+
+    for (std::size_t i = 0; i < values.size(); ++i) {
+        std::vector<std::size_t> expected;
+        for (std::size_t id = 0; id < intervals.size(); ++id) {
+            if (intervals[id].contains(values[i])) {
+                expected.push_back(id);
+            }
+        }
+        std::sort(results[i].begin(), results[i].end());
+        EXPECT_EQ(results[i], expected);
+    }
+}
@@ -0,0 +1,67 @@
+#include "gtest/gtest.h"
+#include "overlap_kernel.h"
+#include <random>
+
+namespace {
+    SimpleIntervalColumns random_columns(std::mt19937 &generator, std::size_t size) {
+        std::uniform_int_distribution<int> bound(0, 40);
+        std::uniform_int_distribution<int> border(0, 1);
+        SimpleIntervalColumns columns;
+        for (std::size_t i = 0; i < size; ++i) {
+            auto lower = static_cast<float>(bound(generator));
+            auto upper = lower + static_cast<float>(bound(generator) % 5);
+            columns.push_back(SimpleInterval{lower, upper, border(generator) ? BorderType::CLOSED : BorderType::OPEN,
+                                             border(generator) ? BorderType::CLOSED : BorderType::OPEN});
+        }
+        return columns;
+    }
+}
+
+TEST(OverlapKernel, MatchesSimpleIntervalIntersection){
+    std::mt19937 generator(0);
+    auto first = random_columns(generator, 37);
+    auto second = random_columns(generator, 53);
+
+    std::vector<IndexPair> expected;
+    for (std::uint32_t i = 0; i < first.size(); ++i) {
+        for (std::uint32_t j = 0; j < second.size(); ++j) {
+            if (!first.at(i).intersection_with(second.at(j)).is_empty()) {
+                expected.emplace_back(i, j);
+            }
+        }
+    }
+
+    std::vector<IndexPair> scalar;
+    overlapping_pairs_scalar(first, second, scalar);
+    EXPECT_EQ(scalar, expected);
+
+    if (avx2_available()) {
+        std::vector<IndexPair> vectorized;
+        overlapping_pairs_avx2(first, second, vectorized);
+        EXPECT_EQ(vectorized, expected);
+    }
+
+    SimpleIntervalColumns intersections;
+    intersect_columns(first, second, intersections);
+    ASSERT_EQ(intersections.size(), expected.size());
+    for (std::size_t k = 0; k < expected.size(); ++k) {
+        auto [i, j] = expected[k];
+        EXPECT_EQ(intersections.at(k), first.at(i).intersection_with(second.at(j)));
+    }
+}
+
+TEST(OverlapKernel, Within){
+    std::mt19937 generator(1);
+    auto columns = random_columns(generator, 29);
+    std::vector<IndexPair> pairs;
+    overlapping_pairs_within(columns, pairs);
+    for (const auto &[i, j]: pairs) {
+        EXPECT_LT(i, j);
+        EXPECT_FALSE(columns.at(i).intersection_with(columns.at(j)).is_empty());
+    }
+
+    EXPECT_TRUE(closed(0, 1).union_with(closed(2, 3)).is_disjoint());
+    auto overlapping = Interval{SimpleSetType<SimpleInterval>{SimpleInterval{0, 1, BorderType::CLOSED, BorderType::CLOSED},
+                                                              SimpleInterval{1, 2, BorderType::CLOSED, BorderType::OPEN}}};
+    EXPECT_FALSE(overlapping.is_disjoint());
+}
@@ -2,6 +2,8 @@
 #include "gtest/gtest.h"
 #include "product_algebra.h"
 #include "algebra_common.h"
+#include "allocation_hook.h"
+#include <cmath>
 
 
 auto x = Continuous("x");
@@ -16,3 +18,412 @@ TEST(ProductAlgebra, Intersection){
     auto event1 = SimpleEvent(vmap_1);
 
 }
+
+TEST(ProductAlgebra, SimpleEventIntersection){
+    std::map<VariableVariant, SetVariant> vmap_1 = {{x, closed(0, 1)}, {y, closed(0, 1)}};
+    std::map<VariableVariant, SetVariant> vmap_2 = {{x, closed(0.5, 2)}, {a, full_domain_of(VisitVariableVariant(a))}};
+    auto event1 = SimpleEvent(vmap_1);
+    auto event2 = SimpleEvent(vmap_2);
+    auto intersection = event1.intersection_with(event2);
+    EXPECT_EQ(intersection.variable_assignments.size(), 3);
+    EXPECT_EQ(std::get<Interval>(intersection.variable_assignments.at(VisitVariableVariant(x))), closed(0.5, 1));
+    EXPECT_EQ(std::get<Interval>(intersection.variable_assignments.at(VisitVariableVariant(y))), closed(0, 1));
+
+    std::map<VariableVariant, SetVariant> vmap_3 = {{x, closed(2, 3)}};
+    EXPECT_TRUE(event1.intersection_with(SimpleEvent(vmap_3)).is_empty());
+}
+
+TEST(ProductAlgebra, SimpleEventComplement){
+    std::map<VariableVariant, SetVariant> vmap = {{x, closed(0, 1)}, {y, closed(0, 1)}};
+    auto event = SimpleEvent(vmap);
+    auto complement = event.complement();
+    EXPECT_EQ(complement.simple_sets.size(), 2);
+    EXPECT_TRUE(complement.is_disjoint());
+    EXPECT_TRUE(complement.intersection_with(event).is_empty());
+
+    auto symbolic_event = SimpleEvent(std::map<VariableVariant, SetVariant>{
+            {x, closed(0, 1)}, {a, Set(SimpleSet("a", {"a", "b", "c"}))}});
+    auto symbolic_complement = symbolic_event.complement();
+    EXPECT_EQ(symbolic_complement.simple_sets.size(), 2);
+    EXPECT_TRUE(symbolic_complement.is_disjoint());
+    EXPECT_TRUE(symbolic_complement.intersection_with(symbolic_event).is_empty());
+}
+
+TEST(ProductAlgebra, SimpleEventDifference){
+    auto event1 = SimpleEvent(std::map<VariableVariant, SetVariant>{{x, closed(0, 3)}, {y, closed(0, 3)}});
+    auto event2 = SimpleEvent(std::map<VariableVariant, SetVariant>{{x, closed(1, 2)}, {y, closed(1, 2)}});
+    auto difference = event1.difference_with(event2);
+    EXPECT_LE(difference.simple_sets.size(), 2);
+    EXPECT_TRUE(difference.is_disjoint());
+    EXPECT_TRUE(difference.intersection_with(event2).is_empty());
+    EXPECT_TRUE(event1.difference_with(event1).is_empty());
+
+    auto event3 = SimpleEvent(std::map<VariableVariant, SetVariant>{{x, closed(5, 6)}, {y, closed(1, 2)}});
+    EXPECT_EQ(event1.difference_with(event3), Event(event1));
+}
+
+TEST(ProductAlgebra, EventComplementAndDifference){
+    auto box1 = SimpleEvent(std::map<VariableVariant, SetVariant>{{x, closed(0, 1)}, {y, closed(0, 1)}});
+    auto box2 = SimpleEvent(std::map<VariableVariant, SetVariant>{{x, closed(2, 3)}, {y, closed(2, 3)}});
+    auto event = Event(SimpleSetType<SimpleEvent>{box1, box2});
+    auto complement = event.complement();
+    EXPECT_TRUE(complement.is_disjoint());
+    EXPECT_TRUE(complement.intersection_with(event).is_empty());
+
+    auto difference = event.difference_with(Event(box1));
+    EXPECT_EQ(difference, Event(box2));
+    EXPECT_TRUE(complement.difference_with(complement).is_empty());
+}
+
+TEST(ProductAlgebra, EventSimplify){
+    auto box1 = SimpleEvent(std::map<VariableVariant, SetVariant>{{x, closed(0, 1)}, {y, closed(0, 1)}});
+    auto box2 = SimpleEvent(std::map<VariableVariant, SetVariant>{{x, open_closed(1, 2)}, {y, closed(0, 1)}});
+    auto box3 = SimpleEvent(std::map<VariableVariant, SetVariant>{{x, closed(0, 2)}, {y, open_closed(1, 3)}});
+    auto event = Event(SimpleSetType<SimpleEvent>{box1, box2, box3});
+    auto simplified = event.simplify();
+
+    auto result_by_hand = SimpleEvent(std::map<VariableVariant, SetVariant>{{x, closed(0, 2)}, {y, closed(0, 3)}});
+    EXPECT_EQ(simplified, Event(result_by_hand));
+
+    auto box4 = SimpleEvent(std::map<VariableVariant, SetVariant>{{x, closed(5, 6)}, {y, closed(5, 6)}});
+    auto unmergeable = Event(SimpleSetType<SimpleEvent>{box1, box4});
+    EXPECT_EQ(unmergeable.simplify(), unmergeable);
+}
+
+TEST(ProductAlgebra, EventBudget){
+    auto box1 = SimpleEvent(std::map<VariableVariant, SetVariant>{{x, closed(0, 1)}, {y, closed(0, 1)}});
+    auto box2 = SimpleEvent(std::map<VariableVariant, SetVariant>{{x, closed(2, 3)}, {y, closed(2, 3)}});
+    auto event = Event(SimpleSetType<SimpleEvent>{box1, box2});
+
+    auto [complement, status] = event.complement(OperationBudget());
+    EXPECT_EQ(status, OperationStatus::OK);
+    EXPECT_EQ(complement, event.complement());
+
+    auto budget = OperationBudget();
+    budget.max_simple_sets = 1;
+    auto [limited_complement, limited_status] = event.complement(budget);
+    EXPECT_EQ(limited_status, OperationStatus::BUDGET_EXCEEDED);
+    EXPECT_TRUE(limited_complement.is_empty());
+
+    // the budget is also checked when no box has to be removed from the complement of the first box
+    auto [box_complement, box_status] = Event(box1).complement(budget);
+    EXPECT_EQ(box_status, OperationStatus::BUDGET_EXCEEDED);
+    EXPECT_TRUE(box_complement.is_empty());
+
+    auto expired = OperationBudget();
+    expired.deadline = std::chrono::steady_clock::now();
+    EXPECT_EQ(std::get<1>(event.complement(expired)), OperationStatus::DEADLINE_EXCEEDED);
+    EXPECT_EQ(std::get<1>(event.difference_with(Event(box1), expired)), OperationStatus::DEADLINE_EXCEEDED);
+}
+
+namespace {
+    std::ptrdiff_t hooked_bytes = 0;
+
+    void count_bytes(std::ptrdiff_t bytes) {
+        hooked_bytes += bytes;
+    }
+}
+
+TEST(ProductAlgebra, MemoryFootprint){
+    auto box = SimpleEvent(std::map<VariableVariant, SetVariant>{{x, closed(0, 1)}, {a, full_domain_of(VisitVariableVariant(a))}});
+    auto event = Event(box);
+    auto footprint = event.memory_footprint();
+    EXPECT_GT(footprint.container_nodes, 2 * tree_node_bytes<VariableAssignmentType::value_type>());
+    EXPECT_GT(footprint.domains, 0);
+    EXPECT_EQ(footprint.total(), footprint.container_nodes + footprint.strings + footprint.domains);
+
+    // copies share the boxes, such that the events of a cache count them once
+    auto events = event.memory_footprint();
+    events += Event(event).memory_footprint();
+    EXPECT_EQ(events.total(), footprint.total());
+
+    auto bytes_before = allocated_bytes();
+    auto allocations_before = allocation_count();
+    auto previous_hook = set_allocation_hook(count_bytes);
+    {
+        auto copy = box;
+        EXPECT_GT(allocated_bytes(), bytes_before);
+    }
+    set_allocation_hook(previous_hook);
+    EXPECT_GT(allocation_count(), allocations_before);
+    EXPECT_EQ(hooked_bytes, 0);
+}
+
+TEST(ProductAlgebra, CopyOnWrite){
+    auto event = Event(SimpleEvent(std::map<VariableVariant, SetVariant>{{x, closed(0, 1)}, {y, closed(0, 1)}}));
+
+    auto allocations_before = allocation_count();
+    auto copy = event;
+    EXPECT_EQ(allocation_count(), allocations_before);
+    EXPECT_TRUE(copy.simple_sets.shares_storage_with(event.simple_sets));
+
+    copy.simple_sets.insert(SimpleEvent(std::map<VariableVariant, SetVariant>{{x, closed(2, 3)}, {y, closed(0, 1)}}));
+    EXPECT_FALSE(copy.simple_sets.shares_storage_with(event.simple_sets));
+    EXPECT_EQ(event.simple_sets.size(), 1);
+    EXPECT_EQ(copy.simple_sets.size(), 2);
+}
+
+TEST(ProductAlgebra, Coarsen){
+    auto fragmented = closed(0, 1).union_with(closed(1.01, 2));
+    auto box1 = SimpleEvent(std::map<VariableVariant, SetVariant>{{x, fragmented}, {y, closed(0, 1)}});
+    auto box2 = SimpleEvent(std::map<VariableVariant, SetVariant>{{x, closed(5, 6)}, {y, closed(2, 3)}});
+    auto event = Event(SimpleSetType<SimpleEvent>{box1, box2});
+
+    auto [coarsened, error] = event.coarsen(1, 0.1);
+    EXPECT_EQ(coarsened.simple_sets.size(), 2);
+    EXPECT_NEAR(error, 0.01, 1e-5);
+    EXPECT_TRUE(coarsened.is_disjoint());
+    EXPECT_EQ(coarsened.intersection_with(event).simplify(), event.simplify());
+
+    // the closed gap is weighted with the extent of the other dimension
+    auto tall = Event(SimpleEvent(std::map<VariableVariant, SetVariant>{{x, fragmented}, {y, closed(0, 10)}}));
+    auto [coarsened_tall, tall_error] = tall.coarsen(1, 0.1);
+    EXPECT_NEAR(tall_error, 0.1, 1e-4);
+    EXPECT_NEAR(tall_error, coarsened_tall.measure() - tall.measure(), 1e-4);
+
+    // the part of the gap that another box already covers is not added
+    auto in_gap = SimpleEvent(std::map<VariableVariant, SetVariant>{{x, closed(1.002, 1.003)}, {y, closed(0, 1)}});
+    auto [coarsened_covered, covered_error] = Event(SimpleSetType<SimpleEvent>{box1, in_gap}).coarsen(1, 0.1);
+    EXPECT_TRUE(coarsened_covered.is_disjoint());
+    EXPECT_NEAR(covered_error, 0.009, 1e-5);
+
+    // the error of an unbounded box is infinite
+    auto unbounded = Event(SimpleEvent(std::map<VariableVariant, SetVariant>{{x, fragmented}, {y, reals()}}));
+    auto [coarsened_unbounded, unbounded_error] = unbounded.coarsen(1, 0.1);
+    EXPECT_EQ(coarsened_unbounded.simple_sets.size(), 1);
+    EXPECT_TRUE(std::isinf(unbounded_error));
+}
+
+TEST(ProductAlgebra, Project){
+    auto box1 = SimpleEvent(std::map<VariableVariant, SetVariant>{{x, closed(0, 2)}, {y, closed(0, 1)}});
+    auto box2 = SimpleEvent(std::map<VariableVariant, SetVariant>{{x, closed(1, 3)}, {y, closed(5, 6)}});
+    auto box3 = SimpleEvent(std::map<VariableVariant, SetVariant>{{x, open(5, 6)}, {y, closed(0, 1)}});
+    auto event = Event(SimpleSetType<SimpleEvent>{box1, box2, box3});
+
+    auto on_x = event.project({VisitVariableVariant(x)});
+    EXPECT_EQ(on_x.simple_sets.size(), 1);
+    auto expected_x = SimpleEvent(std::map<VariableVariant, SetVariant>{{x, closed(0, 3).union_with(open(5, 6))}});
+    EXPECT_EQ(*on_x.simple_sets.begin(), expected_x);
+
+    auto on_y = event.project({VisitVariableVariant(y)});
+    auto expected_y = SimpleEvent(std::map<VariableVariant, SetVariant>{{y, closed(0, 1).union_with(closed(5, 6))}});
+    EXPECT_EQ(on_y.simple_sets.size(), 1);
+    EXPECT_EQ(*on_y.simple_sets.begin(), expected_y);
+
+    EXPECT_TRUE(event.project({}).is_empty());
+}
+
+TEST(ProductAlgebra, ProjectMultipleDimensions){
+    auto all = std::set<std::string>{"a", "b", "c"};
+    auto a_or_b = Set(SimpleSetType<SimpleSet>{SimpleSet("a", all), SimpleSet("b", all)}, all);
+    auto b_only = Set(SimpleSetType<SimpleSet>{SimpleSet("b", all)}, all);
+
+    auto box1 = SimpleEvent(std::map<VariableVariant, SetVariant>{{x, closed(0, 2)}, {y, closed(0, 2)},
+                                                                  {a, a_or_b}});
+    auto box2 = SimpleEvent(std::map<VariableVariant, SetVariant>{{x, closed(1, 3)}, {y, closed(1, 3)},
+                                                                  {a, b_only}});
+    auto box3 = SimpleEvent(std::map<VariableVariant, SetVariant>{{x, closed(0, 2)}, {y, closed(0, 2)},
+                                                                  {a, b_only}});
+    auto event = Event(SimpleSetType<SimpleEvent>{box1, box2, box3});
+
+    auto projection = event.project({VisitVariableVariant(x), VisitVariableVariant(y)});
+    EXPECT_TRUE(projection.is_disjoint());
+
+    auto expected = Event(SimpleSetType<SimpleEvent>{
+            SimpleEvent(std::map<VariableVariant, SetVariant>{{x, closed(0, 2)}, {y, closed(0, 2)}}),
+            SimpleEvent(std::map<VariableVariant, SetVariant>{{x, closed(1, 3)}, {y, closed(1, 3)}})});
+    EXPECT_TRUE(projection.difference_with(expected).is_empty());
+    EXPECT_TRUE(expected.difference_with(projection).is_empty());
+
+    auto on_a = event.project({VisitVariableVariant(a)});
+    EXPECT_EQ(on_a.simple_sets.size(), 1);
+    EXPECT_EQ(std::get<Set>(on_a.simple_sets.begin()->variable_assignments.at(VisitVariableVariant(a))), a_or_b);
+
+    // variables that a box does not constrain take their entire domain
+    auto on_u = event.project({VisitVariableVariant(u)});
+    EXPECT_EQ(std::get<Set>(on_u.simple_sets.begin()->variable_assignments.at(VisitVariableVariant(u))),
+              std::get<Set>(full_domain_of(VisitVariableVariant(u))));
+}
+
+namespace {
+    bool equal_sets(const Event &first, const Event &second) {
+        return first.difference_with(second).is_empty() && second.difference_with(first).is_empty();
+    }
+}
+
+TEST(ProductAlgebra, UnionAll){
+    std::vector<Event> events;
+    for (int i = 0; i < 12; ++i) {
+        auto lower = static_cast<float>(i);
+        events.emplace_back(SimpleEvent(std::map<VariableVariant, SetVariant>{
+                {x, closed(lower, lower + 2)}, {y, closed(lower / 2, lower / 2 + 1)}}));
+    }
+    auto expected = events.front();
+    for (const auto &event: events) {
+        expected = expected.union_with(event);
+    }
+
+    auto result = union_all(events);
+    EXPECT_TRUE(result.is_disjoint());
+    EXPECT_TRUE(equal_sets(result, expected));
+
+    auto parallel_result = union_all(events, true);
+    EXPECT_TRUE(parallel_result.is_disjoint());
+    EXPECT_TRUE(equal_sets(parallel_result, expected));
+
+    EXPECT_TRUE(union_all(std::vector<Event>()).is_empty());
+}
+
+TEST(ProductAlgebra, IntersectionAll){
+    auto all = std::set<std::string>{"a", "b", "c"};
+    auto a_or_b = Set(SimpleSetType<SimpleSet>{SimpleSet("a", all), SimpleSet("b", all)}, all);
+    std::vector<Event> events;
+    for (int i = 0; i < 5; ++i) {
+        auto lower = static_cast<float>(i);
+        auto box1 = SimpleEvent(std::map<VariableVariant, SetVariant>{{x, closed(-lower, 10)}, {a, a_or_b}});
+        auto box2 = SimpleEvent(std::map<VariableVariant, SetVariant>{{x, closed(20, 30 + lower)}});
+        events.emplace_back(SimpleSetType<SimpleEvent>{box1, box2});
+    }
+    auto expected = events.front();
+    for (const auto &event: events) {
+        expected = expected.intersection_with(event);
+    }
+
+    auto result = intersection_all(events, true);
+    EXPECT_TRUE(result.is_disjoint());
+    EXPECT_TRUE(equal_sets(result, expected));
+    EXPECT_TRUE(equal_sets(intersection_all(events), expected));
+    EXPECT_THROW(intersection_all(std::vector<Event>()), std::invalid_argument);
+}
+
+TEST(ProductAlgebra, LazyComplement){
+    auto box1 = SimpleEvent(std::map<VariableVariant, SetVariant>{{x, closed(0, 2)}, {y, closed(0, 2)}});
+    auto box2 = SimpleEvent(std::map<VariableVariant, SetVariant>{{x, closed(1, 3)}, {y, closed(1, 3)}});
+    auto event = Event(box1);
+    auto other = Event(box2);
+
+    auto complement = event.lazy_complement();
+    auto explicit_complement = event.complement();
+    EXPECT_TRUE(equal_sets(complement.materialize(), explicit_complement));
+    EXPECT_TRUE(equal_sets(other.difference_with(complement), other.difference_with(explicit_complement)));
+    EXPECT_TRUE(equal_sets(other.intersection_with(complement), other.intersection_with(explicit_complement)));
+    EXPECT_TRUE(equal_sets(complement.difference_with(other).materialize(),
+                           explicit_complement.difference_with(other)));
+    EXPECT_FALSE(complement.contains(other));
+    EXPECT_TRUE(complement.contains(Event(SimpleEvent(std::map<VariableVariant, SetVariant>{
+            {x, closed(5, 6)}, {y, closed(0, 1)}}))));
+}
+
+TEST(ProductAlgebra, BoundingHull){
+    auto all = std::set<std::string>{"a", "b", "c"};
+    auto a_only = Set(SimpleSetType<SimpleSet>{SimpleSet("a", all)}, all);
+    auto b_only = Set(SimpleSetType<SimpleSet>{SimpleSet("b", all)}, all);
+    auto a_or_b = Set(SimpleSetType<SimpleSet>{SimpleSet("a", all), SimpleSet("b", all)}, all);
+
+    auto box1 = SimpleEvent(std::map<VariableVariant, SetVariant>{{x, closed(0, 1)}, {y, closed(0, 1)}, {a, a_only}});
+    auto box2 = SimpleEvent(std::map<VariableVariant, SetVariant>{{x, closed(2, 3)}, {a, b_only}});
+    auto event = Event(SimpleSetType<SimpleEvent>{box1, box2});
+
+    const auto &hull = event.bounding_hull();
+    EXPECT_FALSE(hull.empty);
+    EXPECT_EQ(hull.intervals.size(), 1);
+    EXPECT_EQ(hull.intervals.at(VisitVariableVariant(x)), SimpleInterval(0, 3, BorderType::CLOSED, BorderType::CLOSED));
+    EXPECT_EQ(hull.symbols.at(VisitVariableVariant(a)), std::vector<std::uint64_t>{3});
+    EXPECT_TRUE(Event().bounding_hull().empty);
+
+    // disjoint in x
+    auto far = Event(SimpleEvent(std::map<VariableVariant, SetVariant>{{x, closed(5, 6)}, {y, closed(0, 1)}}));
+    EXPECT_TRUE(event.bounding_hulls_disjoint(far));
+    EXPECT_TRUE(event.intersection_with(far).is_empty());
+    EXPECT_TRUE(equal_sets(event.difference_with(far), event));
+
+    // disjoint in the symbols
+    auto other_symbol = Event(SimpleEvent(std::map<VariableVariant, SetVariant>{
+            {x, closed(0, 3)}, {a, Set(SimpleSetType<SimpleSet>{SimpleSet("c", all)}, all)}}));
+    EXPECT_TRUE(event.bounding_hulls_disjoint(other_symbol));
+    EXPECT_TRUE(event.intersection_with(other_symbol).is_empty());
+
+    // overlapping hulls of disjoint events are not disjoint
+    auto gap = Event(SimpleEvent(std::map<VariableVariant, SetVariant>{{x, closed(1.5, 1.8)}, {a, a_or_b}}));
+    EXPECT_FALSE(event.bounding_hulls_disjoint(gap));
+    EXPECT_TRUE(event.intersection_with(gap).is_empty());
+
+    // an event that does not bound y is not contained in one that does
+    auto bounded = Event(SimpleEvent(std::map<VariableVariant, SetVariant>{{x, closed(0, 3)}, {y, closed(0, 1)}}));
+    EXPECT_FALSE(bounded.bounding_hull_contains(event));
+    EXPECT_FALSE(bounded.contains(event));
+    EXPECT_TRUE(event.bounding_hull_contains(Event(box1)));
+    EXPECT_TRUE(event.contains(Event(box1)));
+}
+
+TEST(ProductAlgebra, SparseAssignments){
+
+    // many variables of which every box constrains two
+    std::vector<Continuous> variables;
+    for (int i = 0; i < 50; ++i) {
+        variables.emplace_back("v" + std::to_string(i));
+    }
+    auto first = SimpleEvent(std::map<VariableVariant, SetVariant>{{variables[3], closed(0, 1)},
+                                                                   {variables[7], closed(0, 1)}});
+    auto second = SimpleEvent(std::map<VariableVariant, SetVariant>{{variables[7], closed(0.5, 2)},
+                                                                    {variables[20], closed(0, 1)}});
+
+    // the complement leaves the variables after the complemented one unassigned
+    auto complement = first.complement();
+    EXPECT_EQ(complement.simple_sets.size(), 2);
+    for (const auto &box: complement.simple_sets) {
+        EXPECT_LE(box.variable_assignments.size(), 2);
+    }
+    EXPECT_TRUE(Event(first).intersection_with(complement).is_empty());
+
+    // the difference only assigns the variables of both
+    auto difference = first.difference_with(second);
+    for (const auto &box: difference.simple_sets) {
+        EXPECT_LE(box.variable_assignments.size(), 3);
+    }
+    EXPECT_TRUE(difference.intersection_with(Event(second)).is_empty());
+    EXPECT_TRUE(equal_sets(difference.union_with(Event(first).intersection_with(Event(second))), Event(first)));
+
+    // the intersection merges the assignments of both
+    auto intersection = first.intersection_with(second);
+    EXPECT_EQ(intersection.variable_assignments.size(), 3);
+    EXPECT_EQ(std::get<Interval>(intersection.variable_assignments.at(VisitVariableVariant(variables[7]))),
+              closed(0.5, 1));
+
+    // an unassigned variable is only contained in an assignment of its entire domain
+    EXPECT_TRUE(intersection.is_subset_of(first));
+    EXPECT_TRUE(intersection.is_subset_of(second));
+    EXPECT_FALSE(first.is_subset_of(second));
+    EXPECT_FALSE(first.is_subset_of(intersection));
+    auto unbounded = SimpleEvent(std::map<VariableVariant, SetVariant>{{variables[3], closed(0, 1)},
+                                                                       {variables[7], closed(0, 1)},
+                                                                       {variables[40], reals()}});
+    EXPECT_TRUE(first.is_subset_of(unbounded));
+    EXPECT_TRUE(unbounded.is_subset_of(first));
+    EXPECT_TRUE(SimpleEvent().is_subset_of(first));
+}
+
+TEST(ProductAlgebra, MeasureOfUnassignedVariables){
+    auto box = SimpleEvent(std::map<VariableVariant, SetVariant>{{x, closed(0, 1)}});
+    auto removed = SimpleEvent(std::map<VariableVariant, SetVariant>{
+            {x, closed(0, 0.5)}, {a, Set(SimpleSet("a", a.domain.all_elements))}});
+    std::set<VisitVariableVariant> space{VisitVariableVariant(x), VisitVariableVariant(a)};
+
+    // the difference leaves a unassigned in the box (0.5, 1], which still covers all three elements
+    auto difference = box.difference_with(removed);
+    EXPECT_DOUBLE_EQ(box.measure(), 1);
+    EXPECT_DOUBLE_EQ(box.measure(space), 3);
+    EXPECT_DOUBLE_EQ(removed.measure(space), 0.5);
+    EXPECT_DOUBLE_EQ(difference.measure(space), box.measure(space) - removed.measure(space));
+    EXPECT_DOUBLE_EQ(difference.measure(), difference.measure(space));
+
+    // an unassigned continuous variable is unbounded
+    auto strip = SimpleEvent(std::map<VariableVariant, SetVariant>{{x, closed(0, 0.5)}, {y, closed(0, 1)}});
+    auto unbounded_difference = box.difference_with(strip);
+    EXPECT_DOUBLE_EQ(Event(box).measure(), 1);
+    EXPECT_TRUE(std::isinf(unbounded_difference.measure()));
+    EXPECT_TRUE(std::isinf(box.measure(unbounded_difference.variables())));
+
+    EXPECT_EQ(SimpleEvent().measure(space), 0);
+    EXPECT_EQ(Event().measure(), 0);
+}
@@ -0,0 +1,143 @@
+#include "gtest/gtest.h"
+#include "sampling.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+auto sampling_x = Continuous("x");
+auto sampling_n = Integer("n");
+auto sampling_a = Symbolic("a", Set({"a", "b", "c"}));
+
+TEST(Sampling, AliasTable){
+    auto alias_table = AliasTable({1., 0., 3.});
+    auto rng = Xoshiro256(42);
+    std::vector<std::size_t> counts(3, 0);
+    for (int i = 0; i < 40000; ++i) {
+        counts[alias_table.sample(rng)]++;
+    }
+    EXPECT_EQ(counts[1], 0);
+    EXPECT_NEAR(static_cast<double>(counts[2]) / counts[0], 3., 0.2);
+}
+
+TEST(Sampling, Interval){
+    auto interval = closed(0, 1).union_with(open(2, 5));
+    auto sampler = IntervalSampler(interval);
+    EXPECT_EQ(sampler.measure(), 4.);
+
+    auto rng = Xoshiro256(1);
+    std::vector<float> samples(10000);
+    sampler.sample(samples.size(), rng, samples.data());
+    std::size_t in_first_piece = 0;
+    for (auto sample: samples) {
+        EXPECT_TRUE(interval.contains(sample));
+        in_first_piece += sample <= 1;
+    }
+    EXPECT_NEAR(static_cast<double>(in_first_piece) / samples.size(), 0.25, 0.03);
+
+    EXPECT_THROW(IntervalSampler{reals()}, std::invalid_argument);
+}
+
+TEST(Sampling, IntegerInterval){
+    auto sampler = IntervalSampler(open_closed(0, 3), true);
+    EXPECT_EQ(sampler.measure(), 3.);
+    auto rng = Xoshiro256(7);
+    for (int i = 0; i < 1000; ++i) {
+        auto sample = sampler.sample(rng);
+        EXPECT_EQ(sample, std::round(sample));
+        EXPECT_GE(sample, 1);
+        EXPECT_LE(sample, 3);
+    }
+}
+
+TEST(Sampling, Set){
+    auto all_elements = std::set<std::string>{"a", "b", "c"};
+    auto set = Set(SimpleSetType<SimpleSet>{SimpleSet("a", all_elements), SimpleSet("c", all_elements)},
+                   all_elements);
+    auto sampler = SetSampler(set);
+    auto rng = Xoshiro256(3);
+    std::vector<std::size_t> samples(1000);
+    sampler.sample(samples.size(), rng, samples.data());
+    for (auto sample: samples) {
+        EXPECT_TRUE(set.contains(sampler.elements()[sample]));
+    }
+}
+
+TEST(Sampling, Event){
+    auto box1 = SimpleEvent(std::map<VariableVariant, SetVariant>{
+            {sampling_x, closed(0, 1)}, {sampling_a, Set(SimpleSet("a", {"a", "b", "c"}))}});
+    auto box2 = SimpleEvent(std::map<VariableVariant, SetVariant>{
+            {sampling_x, closed(2, 5)}, {sampling_a, full_domain_of(VisitVariableVariant(sampling_a))}});
+    auto event = Event(SimpleSetType<SimpleEvent>{box1, box2});
+    auto sampler = EventSampler(event);
+    ASSERT_EQ(sampler.variables().size(), 2);
+
+    std::vector<float> x_column(5000);
+    std::vector<std::size_t> a_column(5000);
+    auto rng = Xoshiro256::for_thread(5, 2);
+    sampler.sample(x_column.size(), rng, {x_column.data(), a_column.data()});
+
+    std::size_t in_first_box = 0;
+    for (std::size_t i = 0; i < x_column.size(); ++i) {
+        if (x_column[i] <= 1) {
+            EXPECT_EQ(a_column[i], 0);
+            in_first_box++;
+        } else {
+            EXPECT_GE(x_column[i], 2);
+            EXPECT_LT(a_column[i], 3);
+        }
+    }
+    EXPECT_NEAR(static_cast<double>(in_first_box) / x_column.size(), 0.1, 0.02);
+}
+
+TEST(Sampling, EmptyPieces){
+
+    // an open interval between neighbouring floats contains no float
+    auto between = open(1.f, std::nextafter(1.f, 2.f));
+    EXPECT_THROW(IntervalSampler{between}, std::invalid_argument);
+    auto sampler = IntervalSampler(between.union_with(closed(3, 4)));
+    auto rng = Xoshiro256(11);
+    for (int i = 0; i < 100; ++i) {
+        auto sample = sampler.sample(rng);
+        EXPECT_GE(sample, 3);
+        EXPECT_LE(sample, 4);
+    }
+
+    // boxes without integers are never chosen
+    auto no_integers = SimpleEvent(std::map<VariableVariant, SetVariant>{{sampling_n, open(0.25, 0.75)}});
+    auto integers = SimpleEvent(std::map<VariableVariant, SetVariant>{{sampling_n, closed(2, 4)}});
+    auto event_sampler = EventSampler(Event(SimpleSetType<SimpleEvent>{no_integers, integers}));
+    std::vector<float> column(100);
+    event_sampler.sample(column.size(), rng, {column.data()});
+    for (auto sample: column) {
+        EXPECT_GE(sample, 2);
+        EXPECT_LE(sample, 4);
+    }
+    EXPECT_THROW(EventSampler{Event(no_integers)}, std::invalid_argument);
+}
+
+TEST(Sampling, WidePieces){
+
+    // the width of the piece exceeds the range of float
+    auto largest = std::numeric_limits<float>::max();
+    auto sampler = IntervalSampler(open(-largest, largest));
+    auto rng = Xoshiro256(13);
+    std::vector<float> samples(1000);
+    sampler.sample(samples.size(), rng, samples.data());
+    for (auto sample: samples) {
+        EXPECT_TRUE(std::isfinite(sample));
+        EXPECT_GT(sample, -largest);
+        EXPECT_LT(sample, largest);
+    }
+    EXPECT_LT(*std::min_element(samples.begin(), samples.end()), 0);
+    EXPECT_GT(*std::max_element(samples.begin(), samples.end()), 0);
+}
+
+TEST(Sampling, UniformBelow){
+    auto rng = Xoshiro256(13);
+    for (std::uint64_t bound: {std::uint64_t{1}, std::uint64_t{7}, std::uint64_t{1} << 40,
+                               std::numeric_limits<std::uint64_t>::max()}) {
+        for (int i = 0; i < 100; ++i) {
+            EXPECT_LT(rng.uniform_below(bound), bound);
+        }
+    }
+}
@@ -1,5 +1,6 @@
 #include "gtest/gtest.h"
 #include "set.h"
+#include "allocation_hook.h"
 #include <set>
 
 auto all_elements = std::set<std::string>{"mario", "luigi", "peach", "toad"};
@@ -22,3 +23,57 @@ TEST(Emptyness, Set){
     auto set1 = SimpleSet(all_elements);
     EXPECT_TRUE(set1.is_empty());
 }
+
+TEST(MemoryFootprint, Set){
+    auto set = SimpleSet("a very long element name that does not fit into a small string", all_elements).complement();
+    auto footprint = set.memory_footprint();
+    EXPECT_EQ(footprint.container_nodes, 4 * tree_node_bytes<SimpleSet>());
+
+    // the domain is shared by the set and all its elements and therefore counted once
+    EXPECT_EQ(footprint.domains, string_set_memory_footprint(all_elements).total());
+
+    // so are the simple sets and the domain that a copy shares
+    Set copy = set;
+    auto both = set.memory_footprint();
+    both += copy.memory_footprint();
+    EXPECT_EQ(both.total(), footprint.total());
+
+    auto long_element = SimpleSet("a very long element name that does not fit into a small string", all_elements);
+    EXPECT_GT(long_element.memory_footprint().strings, 0);
+}
+
+TEST(UnionAll, Set){
+    auto mario = Set(SimpleSet("mario", all_elements));
+    auto luigi = Set(SimpleSet("luigi", all_elements));
+    auto mario_or_luigi = mario.union_with(luigi);
+    auto result = union_all({mario, luigi, mario_or_luigi});
+    EXPECT_EQ(result, mario_or_luigi);
+    EXPECT_EQ(result.all_elements, all_elements);
+}
+
+TEST(IntersectionAll, Set){
+    auto mario = Set(SimpleSet("mario", all_elements));
+    auto not_mario = SimpleSet("mario", all_elements).complement();
+    auto not_toad = SimpleSet("toad", all_elements).complement();
+
+    auto result = intersection_all({not_mario, not_toad});
+    EXPECT_EQ(result, not_mario.intersection_with(not_toad));
+    EXPECT_TRUE(intersection_all({mario, not_mario, not_toad}).is_empty());
+    EXPECT_THROW(intersection_all({}), std::invalid_argument);
+}
+
+TEST(CopyOnWrite, Set){
+    auto set = SimpleSet("mario", all_elements).complement();
+
+    auto allocations_before = allocation_count();
+    Set copy = set;
+    EXPECT_EQ(allocation_count(), allocations_before);
+    EXPECT_TRUE(copy.simple_sets.shares_storage_with(set.simple_sets));
+    EXPECT_TRUE(copy.all_elements.shares_storage_with(set.all_elements));
+
+    // the elements share the domain of the set they were created from
+    for (const auto &element: copy.simple_sets) {
+        EXPECT_TRUE(element.all_elements.shares_storage_with(set.all_elements));
+    }
+    EXPECT_EQ(copy, set);
+}
@@ -0,0 +1,94 @@
+#include "gtest/gtest.h"
+#include "static_event.h"
+
+namespace {
+    auto static_x = Continuous("x");
+    auto static_n = Integer("n");
+    auto static_color = Symbolic("color", Set({"red", "green", "blue"}));
+
+    using Schema = EventSchema<Continuous, Integer, Symbolic>;
+
+    Set static_colors(const std::set<std::string> &elements) {
+        const auto &all_elements = static_color.domain.all_elements;
+        SimpleSetType<SimpleSet> simple_sets;
+        for (const auto &element: elements) {
+            simple_sets.insert(SimpleSet(element, all_elements));
+        }
+        return Set(simple_sets, all_elements);
+    }
+
+    Schema::StaticSimpleEventType static_box(const Interval &x, const Interval &n, const Set &color) {
+        return Schema::StaticSimpleEventType(std::make_tuple(x, n, color));
+    }
+
+    bool equal_sets(const Event &first, const Event &second) {
+        return first.difference_with(second).is_empty() && second.difference_with(first).is_empty();
+    }
+}
+
+TEST(StaticEvent, SimpleEvent) {
+    static_assert(Schema::dimensions == 3);
+    static_assert(std::is_same_v<std::tuple_element_t<2, Schema::StaticSimpleEventType::Assignments>, Set>);
+
+    auto first = static_box(closed(0, 2), closed(0, 10), static_colors({"red", "blue"}));
+    auto second = static_box(closed(1, 3), closed(5, 20), static_colors({"blue", "green"}));
+
+    auto intersection = first.intersection_with(second);
+    EXPECT_EQ(std::get<0>(intersection.assignments), closed(1, 2));
+    EXPECT_EQ(std::get<1>(intersection.assignments), closed(5, 10));
+    EXPECT_EQ(std::get<2>(intersection.assignments), static_colors({"blue"}));
+    EXPECT_TRUE(intersection.is_subset_of(first));
+    EXPECT_FALSE(first.is_subset_of(second));
+
+    auto disjoint = static_box(closed(5, 6), closed(0, 10), static_colors({"red"}));
+    EXPECT_TRUE(first.intersection_with(disjoint).is_empty());
+
+    // the difference and the complement are disjoint and cover the box
+    auto difference = first.difference_with(second);
+    EXPECT_EQ(difference.size(), 3);
+    for (const auto &box: difference) {
+        EXPECT_TRUE(box.is_subset_of(first));
+        EXPECT_TRUE(box.intersection_with(second).is_empty());
+    }
+    auto complement = first.complement();
+    EXPECT_EQ(complement.size(), 3);
+    for (const auto &box: complement) {
+        EXPECT_TRUE(box.intersection_with(first).is_empty());
+    }
+    EXPECT_EQ(std::get<2>(intersection.complement().back().assignments), static_colors({"red", "green"}));
+}
+
+TEST(StaticEvent, Conversion) {
+    Schema schema(static_x, static_n, static_color);
+    auto first = SimpleEvent(std::map<VariableVariant, SetVariant>{
+            {static_x, closed(0, 2)}, {static_color, static_colors({"red"})}});
+    auto second = SimpleEvent(std::map<VariableVariant, SetVariant>{
+            {static_x, closed(5, 6)}, {static_n, closed(1, 3)}});
+    auto event = Event(SimpleSetType<SimpleEvent>{first, second});
+
+    // unassigned variables take their entire domain
+    auto static_event = schema.from_event(event);
+    ASSERT_EQ(static_event.simple_sets.size(), 2);
+    auto box = schema.from_simple_event(first);
+    EXPECT_EQ(std::get<1>(box.assignments), reals());
+    EXPECT_EQ(std::get<2>(schema.full_box().assignments), static_colors({"red", "green", "blue"}));
+    EXPECT_TRUE(equal_sets(schema.to_event(static_event), event));
+
+    // the operations agree with the ones of events
+    auto other = Event(SimpleEvent(std::map<VariableVariant, SetVariant>{
+            {static_x, closed(1, 5.5)}, {static_color, static_colors({"red", "green"})}}));
+    auto static_other = schema.from_event(other);
+    EXPECT_TRUE(equal_sets(schema.to_event(static_event.intersection_with(static_other)),
+                           event.intersection_with(other)));
+    EXPECT_TRUE(equal_sets(schema.to_event(static_event.difference_with(static_other)),
+                           event.difference_with(other)));
+    EXPECT_TRUE(equal_sets(schema.to_event(static_event.union_with(static_other)), event.union_with(other)));
+    EXPECT_TRUE(equal_sets(schema.to_event(static_event.complement()), event.complement()));
+    EXPECT_TRUE(static_event.union_with(static_event.complement()).difference_with(schema.full_event()).is_empty());
+    EXPECT_TRUE(schema.full_event().difference_with(static_event.union_with(static_event.complement())).is_empty());
+
+    EXPECT_THROW(Schema::StaticEventType().complement(), std::invalid_argument);
+    EXPECT_THROW(schema.from_simple_event(SimpleEvent(std::map<VariableVariant, SetVariant>{
+            {Continuous("z"), closed(0, 1)}})), std::invalid_argument);
+    EXPECT_THROW(Schema(static_x, Integer("x"), static_color), std::invalid_argument);
+}
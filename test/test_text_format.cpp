@@ -0,0 +1,85 @@
+#include <limits>
+#include <sstream>
+#include "gtest/gtest.h"
+#include "text_format.h"
+
+namespace {
+    auto x = Continuous("x");
+    auto n = Integer("n");
+    auto color = Symbolic("color", Set({"red", "green", "blue"}));
+
+    std::vector<VisitVariableVariant> all_variables() {
+        return {VisitVariableVariant(x), VisitVariableVariant(n), VisitVariableVariant(color)};
+    }
+
+    Set colors(const std::set<std::string> &elements) {
+        const auto &all_elements = color.domain.all_elements;
+        SimpleSetType<SimpleSet> simple_sets;
+        for (const auto &element: elements) {
+            simple_sets.insert(SimpleSet(element, all_elements));
+        }
+        return Set(simple_sets, all_elements);
+    }
+}
+
+TEST(TextFormat, Interval){
+    auto interval = closed_open(0, 1).union_with(open(2.5f, std::numeric_limits<float>::infinity()));
+    EXPECT_EQ(format(interval), "[0, 1) u (2.5, inf)");
+    EXPECT_EQ(format(empty()), "∅");
+    EXPECT_EQ(format(reals()), "(-inf, inf)");
+
+    // the shortest representation still round-trips
+    auto third = closed(0.1f + 0.2f, 1.f / 3.f);
+    EXPECT_EQ(parse_interval(format(third)), third);
+
+    std::ostringstream stream;
+    stream << interval;
+    EXPECT_EQ(stream.str(), format(interval));
+}
+
+TEST(TextFormat, ParseInterval){
+    EXPECT_EQ(parse_interval("[0, 1) u (2.5, inf)"),
+              closed_open(0, 1).union_with(open(2.5f, std::numeric_limits<float>::infinity())));
+    EXPECT_EQ(parse_interval("  [ -1e3 ,2] "), closed(-1000, 2));
+    EXPECT_TRUE(parse_interval("∅").is_empty());
+
+    EXPECT_THROW(parse_interval("[0, 1"), std::invalid_argument);
+    EXPECT_THROW(parse_interval("[1, 0]"), std::invalid_argument);
+    EXPECT_THROW(parse_interval("[0, 1] v [2, 3]"), std::invalid_argument);
+    EXPECT_THROW(parse_interval("[a, 1]"), std::invalid_argument);
+    EXPECT_THROW(parse_interval("[nan, 1]"), std::invalid_argument);
+    EXPECT_THROW(parse_interval("[0, -NaN]"), std::invalid_argument);
+}
+
+TEST(TextFormat, Set){
+    auto set = colors({"red", "blue"});
+    EXPECT_EQ(format(set), "blue u red");
+    EXPECT_EQ(parse_set("blue u red", color.domain.all_elements), set);
+    EXPECT_TRUE(parse_set("∅", color.domain.all_elements).is_empty());
+    EXPECT_THROW(parse_set("blue u purple", color.domain.all_elements), std::invalid_argument);
+    EXPECT_THROW(parse_set("blu", color.domain.all_elements), std::invalid_argument);
+
+    // the parsed elements share the domain they were looked up in
+    auto parsed = parse_set("green u red", color.domain.all_elements);
+    EXPECT_TRUE(parsed.all_elements.shares_storage_with(color.domain.all_elements));
+    for (const auto &element: parsed.simple_sets) {
+        EXPECT_TRUE(element.all_elements.shares_storage_with(color.domain.all_elements));
+    }
+}
+
+TEST(TextFormat, Event){
+    auto box1 = SimpleEvent(std::map<VariableVariant, SetVariant>{
+            {x, closed(0, 1).union_with(open(2, 3))}, {n, closed(1, 5)}, {color, colors({"red", "green"})}});
+    auto box2 = SimpleEvent(std::map<VariableVariant, SetVariant>{
+            {x, open_closed(5, 6)}, {n, closed(1, 5)}, {color, colors({"blue"})}});
+    auto event = Event(SimpleSetType<SimpleEvent>{box1, box2});
+
+    auto text = format(event);
+    EXPECT_EQ(parse_event(text, all_variables()), event);
+    EXPECT_EQ(format(box2), "{x: (5, 6], n: [1, 5], color: blue}");
+    EXPECT_TRUE(parse_event("∅", all_variables()).is_empty());
+
+    EXPECT_THROW(parse_event("{y: [0, 1]}", all_variables()), std::invalid_argument);
+    EXPECT_THROW(parse_event("{x: [0, 1]", all_variables()), std::invalid_argument);
+    EXPECT_THROW(parse_event("{x: [0, 1]} trailing", all_variables()), std::invalid_argument);
+}
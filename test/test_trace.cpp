@@ -0,0 +1,96 @@
+#include <cstdio>
+#include "gtest/gtest.h"
+#include "trace.h"
+
+namespace {
+    std::string trace_path() {
+        return ::testing::TempDir() + "random_events_trace.bin";
+    }
+}
+
+TEST(Trace, RecordAndReplay){
+    auto x = Continuous("x");
+    auto color = Symbolic("color", Set({"red", "green", "blue"}));
+    auto box = SimpleEvent(std::map<VariableVariant, SetVariant>{
+            {x, closed(0, 1)}, {color, full_domain_of(VisitVariableVariant(color))}});
+    auto event = Event(box);
+
+    auto first = closed(0, 2);
+    auto second = closed(1, 3).union_with(closed(5, 6));
+
+    TraceRecorder::start(trace_path());
+    EXPECT_TRUE(TraceRecorder::is_recording());
+    auto united = first.union_with(second);
+    auto complement = event.complement();
+    TraceRecorder::stop();
+    EXPECT_FALSE(TraceRecorder::is_recording());
+
+    // operations after stopping are not recorded
+    auto difference = first.difference_with(second);
+
+    TraceReader reader(trace_path());
+    auto union_record = reader.next();
+    ASSERT_TRUE(union_record.has_value());
+    EXPECT_EQ(union_record->operation, TracedOperation::UNION);
+    EXPECT_EQ(std::get<Interval>(union_record->first), first);
+    EXPECT_EQ(std::get<Interval>(*union_record->second), second);
+    EXPECT_EQ(std::get<Interval>(union_record->replay()), united);
+
+    auto complement_record = reader.next();
+    ASSERT_TRUE(complement_record.has_value());
+    EXPECT_EQ(complement_record->operation, TracedOperation::COMPLEMENT);
+    EXPECT_FALSE(complement_record->second.has_value());
+    EXPECT_EQ(std::get<Event>(complement_record->first), event);
+    EXPECT_EQ(std::get<Event>(complement_record->replay()), complement);
+
+    // nested operations such as the make_disjoint of the union are part of the outer operation
+    EXPECT_FALSE(reader.next().has_value());
+    std::remove(trace_path().c_str());
+}
+
+TEST(Trace, PredicatesAndBoxes){
+    auto x = Continuous("x");
+    auto box = SimpleEvent(std::map<VariableVariant, SetVariant>{{x, closed(0, 2)}});
+    auto hole = SimpleEvent(std::map<VariableVariant, SetVariant>{{x, closed(1, 3)}});
+    auto interval = closed(0, 2).union_with(closed(3, 4));
+
+    TraceRecorder::start(trace_path());
+    auto contained = interval.contains(closed(0, 1));
+    auto disjoint = interval.is_disjoint();
+    auto simplified = Event(box).simplify();
+    auto difference = Event(box).difference_with(hole);
+    auto box_difference = box.difference_with(hole);
+    TraceRecorder::stop();
+
+    TraceReader reader(trace_path());
+    auto contains_record = reader.next();
+    ASSERT_TRUE(contains_record.has_value());
+    EXPECT_EQ(contains_record->operation, TracedOperation::CONTAINS);
+    EXPECT_EQ(std::get<Interval>(*contains_record->second), closed(0, 1));
+    EXPECT_EQ(std::get<bool>(contains_record->replay()), contained);
+
+    auto is_disjoint_record = reader.next();
+    ASSERT_TRUE(is_disjoint_record.has_value());
+    EXPECT_EQ(is_disjoint_record->operation, TracedOperation::IS_DISJOINT);
+    EXPECT_EQ(std::get<bool>(is_disjoint_record->replay()), disjoint);
+
+    auto simplify_record = reader.next();
+    ASSERT_TRUE(simplify_record.has_value());
+    EXPECT_EQ(simplify_record->operation, TracedOperation::SIMPLIFY);
+    EXPECT_EQ(std::get<Event>(simplify_record->replay()), simplified);
+
+    // differences with boxes are recorded as differences of events
+    for (const auto &expected: {difference, box_difference}) {
+        auto difference_record = reader.next();
+        ASSERT_TRUE(difference_record.has_value());
+        EXPECT_EQ(difference_record->operation, TracedOperation::DIFFERENCE);
+        EXPECT_EQ(std::get<Event>(*difference_record->second), Event(hole));
+        EXPECT_EQ(std::get<Event>(difference_record->replay()), expected);
+    }
+    EXPECT_FALSE(reader.next().has_value());
+    std::remove(trace_path().c_str());
+}
+
+TEST(Trace, InvalidFile){
+    EXPECT_THROW(TraceReader("/nonexistent/trace.bin"), std::runtime_error);
+}
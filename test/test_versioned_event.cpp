@@ -0,0 +1,132 @@
+#include "gtest/gtest.h"
+#include "versioned_event.h"
+#include <numeric>
+#include <thread>
+
+namespace {
+    auto versioned_x = Continuous("x");
+    auto versioned_y = Continuous("y");
+
+    SimpleEvent versioned_box(const Interval &x, const Interval &y) {
+        return SimpleEvent(std::map<VariableVariant, SetVariant>{{versioned_x, x}, {versioned_y, y}});
+    }
+
+    /**
+     * @return An event of n disjoint unit boxes along x.
+     */
+    Event unit_boxes(int n) {
+        SimpleSetType<SimpleEvent> boxes;
+        for (int i = 0; i < n; ++i) {
+            boxes.insert(versioned_box(closed_open(static_cast<float>(i), static_cast<float>(i + 1)), closed(0, 1)));
+        }
+        return Event(boxes);
+    }
+
+    bool equal_sets(const Event &first, const Event &second) {
+        return first.difference_with(second).is_empty() && second.difference_with(first).is_empty();
+    }
+}
+
+TEST(PersistentSet, InsertErase) {
+    PersistentSet<int> empty;
+    std::vector<PersistentSet<int>> versions{empty};
+    for (int i = 0; i < 100; ++i) {
+        versions.push_back(versions.back().insert((i * 37) % 100));
+    }
+
+    // every version keeps its own elements
+    for (std::size_t i = 0; i < versions.size(); ++i) {
+        EXPECT_EQ(versions[i].size(), i);
+    }
+    EXPECT_TRUE(empty.empty());
+    EXPECT_FALSE(versions[10].contains((10 * 37) % 100));
+    EXPECT_TRUE(versions[11].contains((10 * 37) % 100));
+
+    const auto &full = versions.back();
+    std::vector<int> elements(full.begin(), full.end());
+    std::vector<int> expected(100);
+    std::iota(expected.begin(), expected.end(), 0);
+    EXPECT_EQ(elements, expected);
+    EXPECT_LE(full.height(), 10);
+
+    auto erased = full.erase(50).erase(0).erase(99);
+    EXPECT_EQ(erased.size(), 97);
+    EXPECT_FALSE(erased.contains(50));
+    EXPECT_TRUE(full.contains(50));
+    EXPECT_EQ(full.size(), 100);
+    EXPECT_EQ(erased.erase(50), erased);
+    EXPECT_EQ(erased.insert(50).insert(0).insert(99), full);
+
+    std::set<int> as_set(expected.begin(), expected.end());
+    EXPECT_EQ(PersistentSet<int>(as_set).to_set(), as_set);
+    EXPECT_EQ(PersistentSet<int>(as_set), full);
+}
+
+TEST(PersistentSet, StructuralSharing) {
+    std::set<int> elements;
+    for (int i = 0; i < 1000; ++i) {
+        elements.insert(i);
+    }
+    std::vector<PersistentSet<int>> versions{PersistentSet<int>(elements)};
+    for (int i = 0; i < 100; ++i) {
+        versions.push_back(versions.front().erase(i * 10));
+    }
+
+    // every version copies one path of about log2(1000) nodes instead of all nodes
+    auto nodes = PersistentSet<int>::count_distinct_nodes(versions);
+    EXPECT_LT(nodes, 1000 + 100 * 2 * versions.front().height());
+    EXPECT_EQ(versions.front().size(), 1000);
+    for (std::size_t i = 1; i < versions.size(); ++i) {
+        EXPECT_EQ(versions[i].size(), 999);
+    }
+}
+
+TEST(VersionedEvent, Refinements) {
+    auto base = VersionedEvent(unit_boxes(20));
+    EXPECT_EQ(base.size(), 20);
+    EXPECT_EQ(base.to_event(), unit_boxes(20));
+
+    auto split = versioned_box(closed_open(3, 4), closed(0, 1));
+    auto refinement = Event(SimpleSetType<SimpleEvent>{versioned_box(closed_open(3, 3.5), closed(0, 1)),
+                                                       versioned_box(closed_open(3.5, 4), closed(0, 1))});
+    auto refined = base.replace(split, refinement);
+    EXPECT_EQ(refined.size(), 21);
+    EXPECT_EQ(base.size(), 20);
+    EXPECT_TRUE(equal_sets(refined.to_event(), base.to_event()));
+
+    auto hole = versioned_box(closed(5.5, 7.5), closed(0.25, 0.5));
+    auto cut = refined.difference_with(hole);
+    EXPECT_TRUE(cut.to_event().is_disjoint());
+    EXPECT_TRUE(equal_sets(cut.to_event(), refined.to_event().difference_with(Event(hole))));
+    EXPECT_TRUE(equal_sets(refined.difference_with(Event(hole)).to_event(), cut.to_event()));
+    EXPECT_EQ(refined.size(), 21);
+
+    auto removed = cut.without(versioned_box(closed_open(0, 1), closed(0, 1)));
+    EXPECT_EQ(removed.size(), cut.size() - 1);
+    EXPECT_EQ(removed.with(versioned_box(closed_open(0, 1), closed(0, 1))), cut);
+    EXPECT_EQ(removed.with(SimpleEvent()), removed);
+}
+
+TEST(VersionedEvent, ConcurrentReads) {
+    auto base = VersionedEvent(unit_boxes(50));
+    std::vector<VersionedEvent> versions;
+    for (int i = 0; i < 8; ++i) {
+        versions.push_back(base.difference_with(
+                versioned_box(closed(static_cast<float>(i), static_cast<float>(i) + 0.5f), reals())));
+    }
+
+    std::vector<std::thread> threads;
+    std::vector<std::size_t> sizes(versions.size());
+    for (std::size_t i = 0; i < versions.size(); ++i) {
+        threads.emplace_back([&, i] {
+            sizes[i] = versions[i].to_event().simple_sets.size();
+            sizes[i] += base.to_event().simple_sets.size();
+        });
+    }
+    for (auto &thread: threads) {
+        thread.join();
+    }
+    for (auto size: sizes) {
+        EXPECT_EQ(size, 100);
+    }
+}